@@ -101,6 +101,10 @@ else:
         Tudocomp(name='huff',                            algorithm='encode(huff)'),
         Tudocomp(name='lzw(ternary)',                    algorithm='lzw(coder=bit,lz78trie=ternary)'),
         Tudocomp(name='lz78(ternary)',                   algorithm='lz78(coder=bit,lz78trie=ternary)'),
+        Tudocomp(name='lzw(swiss)',                      algorithm='lzw(coder=bit,lz78trie=swiss)'),
+        Tudocomp(name='lz78(swiss)',                     algorithm='lz78(coder=bit,lz78trie=swiss)'),
+        Tudocomp(name='lzw(compact)',                    algorithm='lzw(coder=bit,lz78trie=compact)'),
+        Tudocomp(name='lz78(compact)',                   algorithm='lz78(coder=bit,lz78trie=compact)'),
         # Some standard Linux compressors
         StdCompressor(name='gzip -1',  binary='gzip',  cflags=['-1'], dflags=['-d']),
         StdCompressor(name='gzip -9',  binary='gzip',  cflags=['-9'], dflags=['-d']),
@@ -41,6 +41,8 @@ bit_interleaving_coder = [
 
 coder = tmp_lz78u_string_coder + bit_interleaving_coder + [
     ("SLECoder",   "coders/SLECoder.hpp",   []),
+    ("StreamVByteCoder", "coders/StreamVByteCoder.hpp", []),
+    ("ContextCoder", "coders/ContextCoder.hpp", []),
 ] 
 
 non_bit_interleaving_coder = [i for i in coder if i not in bit_interleaving_coder]
@@ -73,11 +75,13 @@ lz78_trie = [
     ("lz78::BinarySortedTrie", "compressors/lz78/BinarySortedTrie.hpp", []),
     ("lz78::BinaryTrie",       "compressors/lz78/BinaryTrie.hpp",       []),
     ("lz78::CedarTrie",        "compressors/lz78/CedarTrie.hpp",        []),
+    ("lz78::CompactHashTrie",  "compressors/lz78/CompactHashTrie.hpp",  []),
     ("lz78::ExtHashTrie",       "compressors/lz78/ExtHashTrie.hpp",   []),
     ("lz78::HashTrie",         "compressors/lz78/HashTrie.hpp",         [hash_function,hash_prober,hash_manager]),
     ("lz78::HashTriePlus",         "compressors/lz78/HashTriePlus.hpp",         [hash_function,hash_manager]),
     ("lz78::RollingTrie",   "compressors/lz78/RollingTrie.hpp",   [hash_roll, hash_prober,hash_manager,hash_function]),
     ("lz78::RollingTriePlus",   "compressors/lz78/RollingTriePlus.hpp",   [hash_roll, hash_manager,hash_function]),
+    ("lz78::SwissTrie",        "compressors/lz78/SwissTrie.hpp",        []),
     ("lz78::TernaryTrie",      "compressors/lz78/TernaryTrie.hpp",      []),
 ]
 
@@ -97,6 +101,10 @@ if config_match("^#define Boost_FOUND 1"): lcpc_strat += [
     ("lcpcomp::PLCPStrategy",     "compressors/lcpcomp/compress/PLCPStrategy.hpp",      [])
     ]
 
+lcpc_strat_default = [
+    ("lcpcomp::MaxLCPStrategy",   "compressors/lcpcomp/compress/MaxLCPStrategy.hpp",    []),
+]
+
 lcpc_buffer = [
     ("lcpcomp::ScanDec",       "compressors/lcpcomp/decompress/ScanDec.hpp", []),
     ("lcpcomp::DecodeForwardQueueListBuffer", "compressors/lcpcomp/decompress/DecodeQueueListBuffer.hpp",  []),
@@ -104,9 +112,15 @@ lcpc_buffer = [
     ("lcpcomp::MultimapBuffer",               "compressors/lcpcomp/decompress/MultiMapBuffer.hpp",         []),
 ]
 
+lcpc_buffer_default = [
+    ("lcpcomp::CompactDec",           "compressors/lcpcomp/decompress/CompactDec.hpp",     []),
+]
+
 lcpc_coder = [
     ("ASCIICoder", "coders/ASCIICoder.hpp", []),
     ("SLECoder", "coders/SLECoder.hpp", []),
+    ("StreamVByteCoder", "coders/StreamVByteCoder.hpp", []),
+    ("ContextCoder", "coders/ContextCoder.hpp", []),
 ]
 
 lz78u_strategy = [
@@ -114,19 +128,56 @@ lz78u_strategy = [
     ("lz78u::BufferingStrategy", "compressors/lz78u/BufferingStrategy.hpp", [tmp_lz78u_string_coder]),
 ]
 
-textds = [
-    ("TextDS<>", "ds/TextDS.hpp", [])
+# The default provider of each TextDS slot
+textds_sa_default   = ("SADivSufSort", "ds/SADivSufSort.hpp", [])
+textds_phi_default  = ("PhiFromSA",    "ds/PhiFromSA.hpp",    [])
+textds_plcp_default = ("PLCPFromPhi",  "ds/PLCPFromPhi.hpp",  [])
+textds_lcp_default  = ("LCPFromPLCP",  "ds/LCPFromPLCP.hpp",  [])
+
+textds_sa = [
+    ("SAParallel",   "ds/SAParallel.hpp",   []),
+    ("SAIS",         "ds/SAIS.hpp",         []),
+    ("SAExternal",   "ds/SAExternal.hpp",   []),
+]
+
+textds_plcp = [
+    ("PLCPParallel", "ds/PLCPParallel.hpp", []),
+]
+
+textds_lcp = [
+    ("LCPParallel", "ds/LCPParallel.hpp", []),
+    ("LCPFromBWT",  "ds/LCPFromBWT.hpp",  []),
+    ("LCPSuccinct", "ds/LCPSuccinct.hpp", []),
+]
+
+# Each provider is registered with the defaults for the other slots only,
+# since the product of all slots multiplies the instantiations of every
+# compressor using a TextDS.
+def textds_with(sa = textds_sa_default, plcp = textds_plcp_default, lcp = textds_lcp_default):
+    return ("TextDS", "ds/TextDS.hpp", [[sa], [textds_phi_default], [plcp], [lcp]])
+
+textds_default = [
+    ("TextDS<>", "ds/TextDS.hpp", []),
 ]
 
+textds_variants = \
+    [textds_with(sa = x) for x in textds_sa] + \
+    [textds_with(plcp = x) for x in textds_plcp] + \
+    [textds_with(lcp = x) for x in textds_lcp]
+
+textds = textds_default + textds_variants
+
 compressors = [
-    ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [lcpc_coder, lcpc_strat, lcpc_buffer, textds]),
+    ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [lcpc_coder, lcpc_strat, lcpc_buffer, textds_default]),
+    ("LCPCompressor",               "compressors/LCPCompressor.hpp",               [lcpc_coder[:1], lcpc_strat_default, lcpc_buffer_default, textds_variants]),
     ("LZ78UCompressor",             "compressors/LZ78UCompressor.hpp",             [lz78u_strategy, context_free_coder]),
     ("RunLengthEncoder",            "compressors/RunLengthEncoder.hpp",            []),
     ("LiteralEncoder",              "compressors/LiteralEncoder.hpp",              [coder]),
     ("LZ78Compressor",              "compressors/LZ78Compressor.hpp",              [context_free_coder, lz78_trie]),
     ("LZWCompressor",               "compressors/LZWCompressor.hpp",               [context_free_coder, lz78_trie]),
     ("RePairCompressor",            "compressors/RePairCompressor.hpp",            [non_bit_interleaving_coder]),
-    ("LZSSLCPCompressor",           "compressors/LZSSLCPCompressor.hpp",           [non_bit_interleaving_coder, textds]),
+    ("LZSSLCPCompressor",           "compressors/LZSSLCPCompressor.hpp",           [non_bit_interleaving_coder, textds_default]),
+    ("LZSSLCPCompressor",           "compressors/LZSSLCPCompressor.hpp",           [non_bit_interleaving_coder[:1], textds_variants]),
     ("LZSSSlidingWindowCompressor", "compressors/LZSSSlidingWindowCompressor.hpp", [context_free_coder]),
     ("MTFCompressor",               "compressors/MTFCompressor.hpp",               []),
     ("NoopCompressor",              "compressors/NoopCompressor.hpp",              []),
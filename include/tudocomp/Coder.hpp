@@ -4,6 +4,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/Env.hpp>
 #include <tudocomp/Literal.hpp>
+#include <tudocomp/Statistics.hpp>
 #include <tudocomp/Range.hpp>
 
 namespace tdc {
@@ -73,6 +74,25 @@ public:
         m_out->write_bit(v);
     }
 
+    /// \brief Encodes a sequence of integer values sharing the same range.
+    ///
+    /// This default implementation produces the same output as calling
+    /// the default \ref encode for every value, but packs the values with
+    /// a fixed bit width in bulk.
+    ///
+    /// Coders that override \ref encode for a range type must also override
+    /// this function for that range type, usually with a loop over
+    /// \ref encode.
+    ///
+    /// \tparam value_t The input value type.
+    /// \param v Pointer to the first value to encode.
+    /// \param n The amount of values to encode.
+    /// \param r The value range shared by all values.
+    template<typename value_t>
+    inline void encode_many(const value_t* v, size_t n, const Range& r) {
+        m_out->write_ints(v, n, bits_for(r.max() - r.min()), value_t(r.min()));
+    }
+
     inline const std::shared_ptr<BitOStream>& stream() {
         return m_out;
     }
@@ -138,6 +158,24 @@ public:
         return value_t(m_in->read_bit());
     }
 
+    /// \brief Decodes a sequence of integer values sharing the same range.
+    ///
+    /// This default implementation is the counterpart to
+    /// \ref Encoder::encode_many and reads the values with a fixed bit width.
+    ///
+    /// Coders that override \ref decode for a range type must also override
+    /// this function for that range type, usually with a loop over
+    /// \ref decode.
+    ///
+    /// \tparam value_t The value type.
+    /// \param out Pointer to the first value to decode into.
+    /// \param n The amount of values to decode.
+    /// \param r The value range shared by all values.
+    template<typename value_t>
+    inline void decode_many(value_t* out, size_t n, const Range& r) {
+        m_in->read_ints(out, n, bits_for(r.max() - r.min()), value_t(r.min()));
+    }
+
     inline const std::shared_ptr<BitIStream>& stream() {
         return m_in;
     }
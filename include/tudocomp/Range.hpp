@@ -91,9 +91,9 @@ namespace tdc {
     };
 
     /// \brief Represents the range of valid \ref tdc::len_t values
-    class LengthRange  : public TypeRange<len_t> {
+    class LengthRange  : public Range {
     public:
-        inline constexpr LengthRange(): TypeRange<len_t>() {}
+        inline constexpr LengthRange(): Range(0, LEN_MAX) {}
     };
 
     /// \brief Represents the range of bit values, ie `0` to `1`
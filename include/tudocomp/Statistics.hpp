@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/Literal.hpp>
+
+namespace tdc {
+
+/// \brief Collects the value range of an integer field.
+class FieldStatistics {
+private:
+    size_t m_min;
+    size_t m_max;
+    size_t m_count;
+
+public:
+    inline FieldStatistics()
+        : m_min(SIZE_MAX), m_max(0), m_count(0) {
+    }
+
+    /// \brief Counts a value of the field.
+    /// \param v The value.
+    inline void add(size_t v) {
+        m_min = std::min(m_min, v);
+        m_max = std::max(m_max, v);
+        ++m_count;
+    }
+
+    /// \brief Yields the smallest counted value, or \c SIZE_MAX if none
+    ///        was counted.
+    inline size_t min() const { return m_min; }
+
+    /// \brief Yields the largest counted value, or zero if none was counted.
+    inline size_t max() const { return m_max; }
+
+    /// \brief Yields the amount of counted values.
+    inline size_t count() const { return m_count; }
+};
+
+/// \brief Statistics about the values a compressor is going to encode.
+///
+/// Compressors can fill this while they factorize the input, so that
+/// encoders can set up their models without iterating over the literals
+/// in a separate pass. It contains the histogram of literals and the value
+/// ranges of an arbitrary number of integer fields.
+class Statistics {
+private:
+    std::vector<len_t> m_histogram;
+    size_t m_num_literals;
+    std::vector<FieldStatistics> m_fields;
+
+public:
+    inline Statistics()
+        : m_histogram(ULITERAL_MAX + 1, 0), m_num_literals(0) {
+    }
+
+    /// \brief Counts a literal.
+    /// \param c The literal.
+    inline void add_literal(uliteral_t c) {
+        DCHECK_LT(m_histogram[c], std::numeric_limits<len_t>::max());
+        ++m_histogram[c];
+        ++m_num_literals;
+    }
+
+    /// \brief Yields how often a literal has been counted.
+    /// \param c The literal.
+    inline len_t literal_count(uliteral_t c) const {
+        return m_histogram[c];
+    }
+
+    /// \brief Yields the literal histogram, indexed by literal.
+    inline const std::vector<len_t>& literal_histogram() const {
+        return m_histogram;
+    }
+
+    /// \brief Yields the total amount of counted literals.
+    inline size_t num_literals() const {
+        return m_num_literals;
+    }
+
+    /// \brief Yields the statistics of an integer field.
+    ///
+    /// The fields are numbered by the compressor filling the statistics.
+    ///
+    /// \param i The field number.
+    inline FieldStatistics& field(size_t i) {
+        if(i >= m_fields.size()) m_fields.resize(i + 1);
+        return m_fields[i];
+    }
+
+    /// \brief Yields the statistics of an integer field.
+    /// \param i The field number.
+    inline FieldStatistics field(size_t i) const {
+        return (i < m_fields.size()) ? m_fields[i] : FieldStatistics();
+    }
+};
+
+/// \brief A literal iterator that carries ready-made statistics of the
+///        literals it yields.
+///
+/// Encoders that only need the literal histogram take it from the
+/// statistics (see \ref literal_statistics) instead of iterating.
+///
+/// \tparam literals_t The underlying literal iterator type.
+template<typename literals_t>
+class StatisticsLiterals : LiteralIterator {
+private:
+    literals_t m_literals;
+    const Statistics* m_stats;
+
+public:
+    /// \brief Constructor.
+    ///
+    /// \param literals The underlying literal iterator.
+    /// \param stats The statistics of the literals yielded by the iterator.
+    inline StatisticsLiterals(literals_t&& literals, const Statistics& stats)
+        : m_literals(std::move(literals)), m_stats(&stats) {
+    }
+
+    /// \brief Yields the statistics of the literals.
+    inline const Statistics& statistics() const {
+        return *m_stats;
+    }
+
+    /// \brief Tests whether there are more literals in the stream.
+    inline bool has_next() const {
+        return m_literals.has_next();
+    }
+
+    /// \brief Yields the next literal from the stream.
+    inline Literal next() {
+        return m_literals.next();
+    }
+};
+
+/// \brief Creates a \ref StatisticsLiterals iterator.
+///
+/// \param literals The underlying literal iterator.
+/// \param stats The statistics of the literals yielded by the iterator.
+template<typename literals_t>
+inline StatisticsLiterals<literals_t> with_statistics(
+    literals_t literals, const Statistics& stats) {
+
+    return StatisticsLiterals<literals_t>(std::move(literals), stats);
+}
+
+/// \cond INTERNAL
+template<typename T>
+struct is_statistics_literals : std::false_type {};
+
+template<typename literals_t>
+struct is_statistics_literals<StatisticsLiterals<literals_t>> : std::true_type {};
+
+template<typename literals_t>
+inline Statistics literal_statistics(literals_t& literals, std::false_type) {
+    Statistics stats;
+    while(literals.has_next()) {
+        stats.add_literal(literals.next().c);
+    }
+    return stats;
+}
+
+template<typename literals_t>
+inline Statistics literal_statistics(literals_t& literals, std::true_type) {
+    return literals.statistics();
+}
+/// \endcond
+
+/// \brief Yields the statistics of the literals of a literal iterator.
+///
+/// If the iterator carries ready-made statistics, these are returned
+/// without iterating. Otherwise, the iterator is consumed to count the
+/// literals.
+///
+/// \param literals The literal iterator.
+/// \return The literal statistics.
+template<typename literals_t>
+inline Statistics literal_statistics(literals_t& literals) {
+    return literal_statistics(literals,
+        is_statistics_literals<typename std::decay<literals_t>::type>());
+}
+
+}
@@ -47,6 +47,11 @@ public:
         inline void encode(value_t v, const BitRange& r) {
             m_out->write_int(v ? '1' : '0');
         }
+
+        template<typename value_t, typename range_t>
+        inline void encode_many(const value_t* v, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
     };
 
     /// \brief Decodes data from an ASCII character stream.
@@ -82,6 +87,11 @@ public:
             uint8_t b = m_in->read_int<uint8_t>();
             return (b != '0');
         }
+
+        template<typename value_t, typename range_t>
+        inline void decode_many(value_t* out, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
     };
 };
 
@@ -824,6 +824,13 @@ namespace tdc {
                 adaphuff::encode(&enc_codingtree, *m_out, v);
             }
 
+            using tdc::Encoder::encode_many; // default encoding as fallback
+
+            template<typename value_t>
+            inline void encode_many(const value_t* v, size_t n, const LiteralRange& r) {
+                for(size_t i = 0; i < n; ++i) encode(v[i], r);
+            }
+
         };
 
         class Decoder : public tdc::Decoder {
@@ -850,6 +857,13 @@ namespace tdc {
             inline value_t decode(const LiteralRange &) {
                 return adaphuff::decode(*m_in, &dec_codingtree);
             }
+
+            using tdc::Decoder::decode_many; // default decoding as fallback
+
+            template<typename value_t>
+            inline void decode_many(value_t* out, size_t n, const LiteralRange& r) {
+                for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+            }
         };
     };
 
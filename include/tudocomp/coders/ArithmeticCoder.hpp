@@ -40,26 +40,6 @@ public:
         len_t literal_counter = 0;
         ulong min_range=std::numeric_limits<len_t>::max();
 
-        /**
-         * @brief count_alphabet_literals counts how often a literal occurs in \ref input
-         * @param input
-         * @return an array with count of each single literal
-         */
-        template<class T>
-        std::vector<len_t> count_alphabet_literals(T&& input) {
-            std::vector<len_t> C;
-            C.resize(ULITERAL_MAX+1, 0);
-
-            while(input.has_next()) {
-                literal_t c = input.next().c;
-                DCHECK_LT(static_cast<uliteral_t>(c), ULITERAL_MAX+1);
-                DCHECK_LT(C[static_cast<uliteral_t>(c)], std::numeric_limits<len_t>::max());
-                ++C[static_cast<uliteral_t>(c)];
-            }
-
-            return C;
-        }
-
         /**
          * @brief build_intervals transforms the counts to an interval-mapping.
          * Every entry contains the difference to the entry before.
@@ -128,12 +108,12 @@ public:
 
             if(C[0]!=0) {
                 m_out->write_int(literal_t(0));
-                m_out->write_int(C[0]);
+                m_out->write_int<len_t>(C[0]);
             }
             for(ulong i=1; i<=ULITERAL_MAX;i++) {
                 if(C[i]!=C[i-1]) {
                     m_out->write_int((literal_t) i);
-                    m_out->write_int(C[i]);
+                    m_out->write_int<len_t>(C[i]);
                 }
 
             }
@@ -154,7 +134,7 @@ public:
         template<typename literals_t>
         inline Encoder(Env&& env, Output& out, literals_t&& literals)
             : tdc::Encoder(std::move(env), out, literals),
-        C(count_alphabet_literals(std::move(literals))) {
+        C(literal_statistics(literals).literal_histogram()) {
             build_intervals(C);
             writeCodebook();
         }
@@ -170,12 +150,19 @@ public:
                 postProcessing();
             }
         }
+
+        using tdc::Encoder::encode_many; // default encoding as fallback
+
+        template<typename value_t>
+        inline void encode_many(const value_t* v, size_t n, const LiteralRange& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
     };
 
     /// \brief Decodes data from an Arithmetic character stream.
     class Decoder : public tdc::Decoder {
     private:
-        std::vector<std::pair<literal_t ,int>> literals;
+        std::vector<std::pair<literal_t, len_t>> literals;
         std::string decoded;
         uliteral_t codebook_size;
         len_t literal_count = 0;
@@ -197,7 +184,7 @@ public:
                 ulong interval_lower_bound = lower_bound;
                 //search the right interval
                 for(int i = 0; i < codebook_size ; i++) {
-                    const std::pair<literal_t, int>& pair=literals[i];
+                    const std::pair<literal_t, len_t>& pair=literals[i];
                     const ulong offset = range <= interval_parts ? range*pair.second/interval_parts : range/interval_parts*pair.second;
                     upper_bound = lower_bound + offset;
                     if(code < upper_bound) {
@@ -226,8 +213,8 @@ public:
             //read and parse dictionary - is is already "normalized"
             for (int i =0; i<codebook_size; i++) {
                 literal_t c = m_in->read_int<literal_t>();
-                int val = m_in->read_int<int>();
-                literals[i]=std::pair<literal_t, int>(c, val);
+                len_t val = m_in->read_int<len_t>();
+                literals[i]=std::pair<literal_t, len_t>(c, val);
             }
 
             min_range=literals[codebook_size-1].second;
@@ -258,6 +245,13 @@ public:
 
             return val;
         }
+
+        using tdc::Decoder::decode_many; // default decoding as fallback
+
+        template<typename value_t>
+        inline void decode_many(value_t* out, size_t n, const LiteralRange& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
     };
 };
 
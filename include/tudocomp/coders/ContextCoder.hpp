@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <tudocomp/Coder.hpp>
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace cabac {
+
+    /// Integer probability state of a binary context, representing the
+    /// probability that the next decision is zero.
+    typedef uint16_t prob_t;
+
+    /// Precision of a probability state in bits.
+    constexpr size_t PROB_BITS = 16;
+
+    /// Adaptation speed of probability states (higher is slower).
+    constexpr size_t ADAPT_SHIFT = 5;
+
+    /// Initial probability state (one half).
+    constexpr prob_t PROB_INIT = prob_t(1U << (PROB_BITS - 1));
+
+    /// The range is renormalized when it falls below this value.
+    constexpr uint32_t RANGE_TOP = 1U << 24;
+
+    /// Adapts a probability state to a coded decision.
+    inline void update(prob_t& p, bool bit) {
+        if(bit) p -= p >> ADAPT_SHIFT;
+        else    p += ((1U << PROB_BITS) - p) >> ADAPT_SHIFT;
+    }
+
+    /// The context model shared by the encoder and decoder.
+    struct Model {
+        /// Context of the end-of-stream decision preceding each symbol.
+        prob_t more;
+
+        /// Contexts of bits, selected by the two previously coded bits.
+        prob_t bits[4];
+        uint8_t bit_history;
+
+        /// Binary tree of contexts for literals.
+        prob_t literal[256];
+
+        /// Contexts of the unary bit length prefix of integers, selected
+        /// by the bit width of the range and the unary position.
+        prob_t prefix[65][64];
+
+        /// Contexts of the bits following the most significant one bit of
+        /// integers, selected by bit length and bit position.
+        prob_t mantissa[65][64];
+
+        inline Model() : more(PROB_INIT), bit_history(0) {
+            std::fill(bits, bits + 4, PROB_INIT);
+            std::fill(literal, literal + 256, PROB_INIT);
+            std::fill(&prefix[0][0], &prefix[0][0] + 65 * 64, PROB_INIT);
+            std::fill(&mantissa[0][0], &mantissa[0][0] + 65 * 64, PROB_INIT);
+        }
+    };
+
+    /// Binary range encoder writing bytes to a bit output stream.
+    class RangeEncoder {
+        BitOStream* m_out;
+
+        uint64_t m_low = 0;
+        uint32_t m_range = 0xFFFFFFFFU;
+        uint8_t m_cache = 0;
+        uint64_t m_cache_size = 1;
+
+        inline void shift_low() {
+            if(uint32_t(m_low) < 0xFF000000U || (m_low >> 32) != 0) {
+                const uint8_t carry = uint8_t(m_low >> 32);
+                uint8_t temp = m_cache;
+                do {
+                    m_out->write_int(uint8_t(temp + carry));
+                    temp = 0xFF;
+                } while(--m_cache_size != 0);
+                m_cache = uint8_t(uint32_t(m_low) >> 24);
+            }
+            ++m_cache_size;
+            m_low = uint64_t(uint32_t(m_low) << 8);
+        }
+
+    public:
+        inline RangeEncoder(BitOStream& out) : m_out(&out) {
+        }
+
+        inline void encode(prob_t& p, bool bit) {
+            const uint32_t bound = (m_range >> PROB_BITS) * p;
+            if(bit) {
+                m_low += bound;
+                m_range -= bound;
+            } else {
+                m_range = bound;
+            }
+            update(p, bit);
+
+            while(m_range < RANGE_TOP) {
+                m_range <<= 8;
+                shift_low();
+            }
+        }
+
+        inline void flush() {
+            for(size_t i = 0; i < 5; i++) shift_low();
+        }
+    };
+
+    /// Binary range decoder reading bytes from a bit input stream.
+    class RangeDecoder {
+        BitIStream* m_in;
+
+        uint32_t m_code = 0;
+        uint32_t m_range = 0xFFFFFFFFU;
+
+    public:
+        inline RangeDecoder(BitIStream& in) : m_in(&in) {
+            for(size_t i = 0; i < 5; i++) {
+                m_code = (m_code << 8) | m_in->read_int<uint8_t>();
+            }
+        }
+
+        inline bool decode(prob_t& p) {
+            const uint32_t bound = (m_range >> PROB_BITS) * p;
+            bool bit;
+            if(m_code < bound) {
+                m_range = bound;
+                bit = false;
+            } else {
+                m_code -= bound;
+                m_range -= bound;
+                bit = true;
+            }
+            update(p, bit);
+
+            while(m_range < RANGE_TOP) {
+                m_range <<= 8;
+                m_code = (m_code << 8) | m_in->read_int<uint8_t>();
+            }
+            return bit;
+        }
+    };
+}
+/// \endcond
+
+/// \brief Adaptive binary arithmetic coder with context modelling.
+///
+/// Every value is binarized and the resulting binary decisions are coded
+/// with a range coder using adaptive integer probability states, similar
+/// to CABAC. Bits are modelled by the two preceding bits, literals by a
+/// binary tree over their bits and integers by a unary prefix of their bit
+/// length followed by the remaining bits, both with contexts depending on
+/// the range and position.
+///
+/// This is most effective for streams with many predictable flags, at the
+/// cost of slower coding of plain integers.
+class ContextCoder : public Algorithm {
+public:
+    /// \brief Yields the coder's meta information.
+    /// \sa Meta
+    inline static Meta meta() {
+        Meta m("coder", "context", "Adaptive binary arithmetic coding with context modelling");
+        return m;
+    }
+
+    /// \cond DELETED
+    ContextCoder() = delete;
+    /// \endcond
+
+    /// \brief Encodes data using adaptive binary arithmetic coding.
+    class Encoder : public tdc::Encoder {
+    private:
+        cabac::Model m_model;
+        cabac::RangeEncoder m_rc;
+
+        inline void encode_more(bool more) {
+            m_rc.encode(m_model.more, more);
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals), m_rc(*m_out) {
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        ~Encoder() {
+            encode_more(false);
+            m_rc.flush();
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const Range& r) {
+            encode_more(true);
+
+            const uint64_t x = uint64_t(v - r.min());
+            const size_t w = bits_for(r.delta());
+            const size_t k = bits_hi(x);
+            DCHECK_LE(k, w);
+
+            // truncated unary code of the bit length
+            for(size_t i = 0; i < k; i++) m_rc.encode(m_model.prefix[w][i], 1);
+            if(k < w) m_rc.encode(m_model.prefix[w][k], 0);
+
+            // bits following the most significant one bit
+            for(size_t i = k > 0 ? k - 1 : 0; i > 0; i--) {
+                m_rc.encode(m_model.mantissa[k][i - 1], (x >> (i - 1)) & 1);
+            }
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            encode_more(true);
+
+            const uliteral_t c = uliteral_t(v);
+            size_t node = 1;
+            for(size_t i = 8; i > 0; i--) {
+                const bool bit = (c >> (i - 1)) & 1;
+                m_rc.encode(m_model.literal[node], bit);
+                node = (node << 1) | bit;
+            }
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const BitRange&) {
+            encode_more(true);
+
+            const bool bit = (v != value_t(0));
+            m_rc.encode(m_model.bits[m_model.bit_history], bit);
+            m_model.bit_history = ((m_model.bit_history << 1) | bit) & 3;
+        }
+
+        template<typename value_t, typename range_t>
+        inline void encode_many(const value_t* v, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
+    };
+
+    /// \brief Decodes data using adaptive binary arithmetic coding.
+    class Decoder : public tdc::Decoder {
+    private:
+        cabac::Model m_model;
+        cabac::RangeDecoder m_rc;
+        bool m_more;
+
+        inline void decode_more() {
+            m_more = m_rc.decode(m_model.more);
+        }
+
+    public:
+        inline Decoder(Env&& env, std::shared_ptr<BitIStream> in)
+            : tdc::Decoder(std::move(env), in), m_rc(*m_in) {
+            decode_more();
+        }
+
+        inline Decoder(Env&& env, Input& in)
+            : Decoder(std::move(env), std::make_shared<BitIStream>(in)) {
+        }
+
+        inline bool eof() const {
+            return !m_more;
+        }
+
+        template<typename value_t>
+        inline value_t decode(const Range& r) {
+            const size_t w = bits_for(r.delta());
+
+            size_t k = 0;
+            while(k < w && m_rc.decode(m_model.prefix[w][k])) ++k;
+
+            uint64_t x = (k > 0) ? 1 : 0;
+            for(size_t i = k > 0 ? k - 1 : 0; i > 0; i--) {
+                x = (x << 1) | m_rc.decode(m_model.mantissa[k][i - 1]);
+            }
+
+            decode_more();
+            return value_t(x + r.min());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange&) {
+            size_t node = 1;
+            for(size_t i = 0; i < 8; i++) {
+                node = (node << 1) | m_rc.decode(m_model.literal[node]);
+            }
+
+            decode_more();
+            return value_t(uliteral_t(node));
+        }
+
+        template<typename value_t>
+        inline value_t decode(const BitRange&) {
+            const bool bit = m_rc.decode(m_model.bits[m_model.bit_history]);
+            m_model.bit_history = ((m_model.bit_history << 1) | bit) & 3;
+
+            decode_more();
+            return value_t(bit);
+        }
+
+        template<typename value_t, typename range_t>
+        inline void decode_many(value_t* out, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
+    };
+};
+
+}
@@ -22,6 +22,11 @@ public:
         inline void encode(value_t v, const Range&) {
             m_out->write_elias_gamma(v);
         }
+
+        template<typename value_t, typename range_t>
+        inline void encode_many(const value_t* v, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -33,6 +38,11 @@ public:
         inline value_t decode(const Range&) {
             return m_in->read_elias_gamma<value_t>();
         }
+
+        template<typename value_t, typename range_t>
+        inline void decode_many(value_t* out, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
     };
 };
 
@@ -32,17 +32,14 @@ namespace huff {
         }
         return C;
     }
+    /** Counts the literals of a literal iterator.
+     *  Ready-made statistics carried by the iterator are used without iterating.
+     */
     template<class T>
-    len_t* count_alphabet_literals(T&& input) {
+    len_t* count_alphabet_literals(T& input) {
+        const Statistics stats = literal_statistics(input);
         len_t* C { new len_t[ULITERAL_MAX+1] };
-        std::memset(C, 0, sizeof(len_t)*(ULITERAL_MAX+1));
-
-        while(input.has_next()) {
-            literal_t c = input.next().c;
-            DCHECK_LT(static_cast<uliteral_t>(c), ULITERAL_MAX+1);
-            DCHECK_LT(C[static_cast<uliteral_t>(c)], std::numeric_limits<len_t>::max());
-            ++C[static_cast<uliteral_t>(c)];
-        }
+        std::copy(stats.literal_histogram().begin(), stats.literal_histogram().end(), C);
         return C;
     }
     /** Computes an array that maps from the effective alphabet to the full alphabet.
@@ -522,7 +519,7 @@ public:
             : tdc::Encoder(std::move(env), out, literals),
             m_table{ [&] () {
                 if(tdc_likely(!literals.has_next())) return huff::extended_huffmantable { nullptr, nullptr, nullptr, 0, nullptr, 0 };
-                const len_t*const C = huff::count_alphabet_literals(std::move(literals));
+                const len_t*const C = huff::count_alphabet_literals(literals);
                 const len_t alphabet_size = huff::effective_alphabet_size(C);
                 if(tdc_unlikely(alphabet_size == 1)) {
                     delete [] C;
@@ -562,6 +559,13 @@ public:
             else
                 huff::huffman_encode(v, *m_out, m_table.ordered_codelengths, ordered_map_to_effective, m_table.alphabet_size, m_table.codewords);
         }
+
+        using tdc::Encoder::encode_many; // default encoding as fallback
+
+        template<typename value_t>
+        inline void encode_many(const value_t* v, size_t n, const LiteralRange& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -605,6 +609,13 @@ public:
                 return m_in->read_int<uliteral_t>();
             return huff::huffman_decode(*m_in, ordered_map_from_effective, prefix_sum_lengths, firstcodes);
         }
+
+        using tdc::Decoder::decode_many; // default decoding as fallback
+
+        template<typename value_t>
+        inline void decode_many(value_t* out, size_t n, const LiteralRange& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
     };
 };
 
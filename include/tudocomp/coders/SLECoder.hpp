@@ -306,6 +306,11 @@ public:
             flush_kmer(); // k-mer interrupted
 			m_out->write_bit(v);
         }
+
+        template<typename value_t, typename range_t>
+        inline void encode_many(const value_t* v, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
     };
 
     class Decoder : public tdc::Decoder {
@@ -448,6 +453,11 @@ public:
             reset_kmer(); // current k-mer interrupted
 			return value_t(m_in->read_bit());
 		}
+
+        template<typename value_t, typename range_t>
+        inline void decode_many(value_t* out, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
     };
 };
 
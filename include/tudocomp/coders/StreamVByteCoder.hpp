@@ -0,0 +1,306 @@
+#pragma once
+
+#include <vector>
+#include <tudocomp/Coder.hpp>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace svbyte {
+
+    /// Lookup tables indexed by a control byte.
+    struct tables_t {
+        /// Total amount of data bytes of the four integers.
+        uint8_t length[256];
+
+        /// Shuffle mask spreading the data bytes to four 32-bit integers.
+        uint8_t shuffle[256][16];
+    };
+
+    inline tables_t make_tables() {
+        tables_t t;
+        for(size_t c = 0; c < 256; c++) {
+            size_t pos = 0;
+            for(size_t j = 0; j < 4; j++) {
+                const size_t len = ((c >> (2 * j)) & 3) + 1;
+                for(size_t b = 0; b < 4; b++) {
+                    t.shuffle[c][4 * j + b] = (b < len) ? uint8_t(pos++) : 0xFF;
+                }
+            }
+            t.length[c] = uint8_t(pos);
+        }
+        return t;
+    }
+
+    inline const tables_t& tables() {
+        static const tables_t t = make_tables();
+        return t;
+    }
+
+    /// Amount of bytes needed to store an integer.
+    inline size_t byte_length(uint32_t x) {
+        return (x < (1U << 8)) ? 1 : (x < (1U << 16)) ? 2 : (x < (1U << 24)) ? 3 : 4;
+    }
+
+    /// Amount of data bytes described by the control bytes of n integers.
+    inline size_t data_length(const uint8_t* ctrl, size_t n) {
+        const tables_t& t = tables();
+
+        size_t len = 0;
+        for(size_t i = 0; i < n / 4; i++) len += t.length[ctrl[i]];
+        for(size_t j = 0; j < n % 4; j++) len += ((ctrl[n / 4] >> (2 * j)) & 3) + 1;
+        return len;
+    }
+
+    /// Encodes n integers into control bytes and little endian data bytes.
+    inline void encode(const uint32_t* in, size_t n,
+                       std::vector<uint8_t>& ctrl, std::vector<uint8_t>& data) {
+
+        ctrl.assign(idiv_ceil(n, 4), 0);
+        data.clear();
+        data.reserve(4 * n);
+
+        for(size_t i = 0; i < n; i++) {
+            const uint32_t x = in[i];
+            const size_t len = byte_length(x);
+
+            ctrl[i / 4] |= uint8_t((len - 1) << (2 * (i % 4)));
+            for(size_t b = 0; b < len; b++) data.push_back(uint8_t(x >> (8 * b)));
+        }
+    }
+
+    /// Decodes n integers from control bytes and data bytes.
+    ///
+    /// The data must be followed by at least 16 bytes of padding.
+    inline void decode(const uint8_t* ctrl, const uint8_t* data, size_t n,
+                       uint32_t* out) {
+
+        size_t i = 0;
+#ifdef __SSSE3__
+        const tables_t& t = tables();
+        for(; i + 4 <= n; i += 4) {
+            const uint8_t c = ctrl[i / 4];
+            const __m128i mask = _mm_loadu_si128((const __m128i*)t.shuffle[c]);
+            const __m128i x = _mm_loadu_si128((const __m128i*)data);
+            _mm_storeu_si128((__m128i*)(out + i), _mm_shuffle_epi8(x, mask));
+            data += t.length[c];
+        }
+#endif
+        for(; i < n; i++) {
+            const size_t len = ((ctrl[i / 4] >> (2 * (i % 4))) & 3) + 1;
+
+            uint32_t x = 0;
+            for(size_t b = 0; b < len; b++) x |= uint32_t(*data++) << (8 * b);
+            out[i] = x;
+        }
+    }
+}
+/// \endcond
+
+/// \brief Byte-aligned integer coder using the Stream-VByte layout.
+///
+/// Integers are buffered in blocks and written as a sequence of control
+/// bytes, each describing the byte lengths of four integers, followed by the
+/// data bytes. Literals and bits are buffered separately and written after
+/// each block, so the whole output stays byte aligned.
+///
+/// This trades compression for decoding speed: a block of integers is
+/// decoded with one byte shuffle per four integers where SSSE3 is available.
+/// Ranges wider than 32 bits are split into two 32-bit integers.
+class StreamVByteCoder : public Algorithm {
+public:
+    /// \brief Yields the coder's meta information.
+    /// \sa Meta
+    inline static Meta meta() {
+        Meta m("coder", "svbyte", "Stream-VByte byte-aligned integer encoding");
+        return m;
+    }
+
+    /// \cond DELETED
+    StreamVByteCoder() = delete;
+    /// \endcond
+
+    /// The amount of integers per block.
+    static constexpr size_t BLOCK_SIZE = 1ULL << 14;
+
+    /// \brief Encodes data into Stream-VByte blocks.
+    class Encoder : public tdc::Encoder {
+    private:
+        std::vector<uint32_t> m_ints;
+        std::vector<uint8_t> m_literals;
+        std::vector<uint8_t> m_bits;
+        size_t m_num_bits = 0;
+
+        inline void write_bytes(const std::vector<uint8_t>& v) {
+            m_out->write_bytes(v.data(), v.size());
+        }
+
+        inline void flush() {
+            if(m_ints.empty() && m_literals.empty() && m_num_bits == 0) {
+                return;
+            }
+
+            m_out->write_compressed_int(m_ints.size());
+            m_out->write_compressed_int(m_literals.size());
+            m_out->write_compressed_int(m_num_bits);
+
+            std::vector<uint8_t> ctrl, data;
+            svbyte::encode(m_ints.data(), m_ints.size(), ctrl, data);
+            write_bytes(ctrl);
+            write_bytes(data);
+            write_bytes(m_literals);
+            write_bytes(m_bits);
+
+            m_ints.clear();
+            m_literals.clear();
+            m_bits.clear();
+            m_num_bits = 0;
+        }
+
+        inline void push_int(uint32_t x) {
+            m_ints.push_back(x);
+            if(m_ints.size() == BLOCK_SIZE) flush();
+        }
+
+    public:
+        template<typename literals_t>
+        inline Encoder(Env&& env, std::shared_ptr<BitOStream> out, literals_t&& literals)
+            : tdc::Encoder(std::move(env), out, literals) {
+            m_ints.reserve(BLOCK_SIZE);
+        }
+
+        template<typename literals_t>
+        inline Encoder(Env&& env, Output& out, literals_t&& literals)
+            : Encoder(std::move(env), std::make_shared<BitOStream>(out), literals) {
+        }
+
+        ~Encoder() {
+            flush();
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const Range& r) {
+            const uint64_t x = uint64_t(v - r.min());
+            push_int(uint32_t(x));
+            if(bits_for(r.delta()) > 32) push_int(uint32_t(x >> 32));
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const LiteralRange&) {
+            m_literals.push_back(uint8_t(v));
+        }
+
+        template<typename value_t>
+        inline void encode(value_t v, const BitRange&) {
+            if(m_num_bits % 8 == 0) m_bits.push_back(0);
+            if(v) m_bits.back() |= uint8_t(1U << (m_num_bits % 8));
+            ++m_num_bits;
+        }
+
+        template<typename value_t, typename range_t>
+        inline void encode_many(const value_t* v, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) encode(v[i], r);
+        }
+    };
+
+    /// \brief Decodes data from Stream-VByte blocks.
+    class Decoder : public tdc::Decoder {
+    private:
+        std::vector<uint32_t> m_ints;
+        std::vector<uint8_t> m_literals;
+        std::vector<uint8_t> m_bits;
+        size_t m_num_bits = 0;
+
+        size_t m_int_pos = 0;
+        size_t m_literal_pos = 0;
+        size_t m_bit_pos = 0;
+
+        inline bool block_done() const {
+            return m_int_pos == m_ints.size() &&
+                   m_literal_pos == m_literals.size() &&
+                   m_bit_pos == m_num_bits;
+        }
+
+        inline void read_bytes(std::vector<uint8_t>& v, size_t n, size_t padding = 0) {
+            v.assign(n + padding, 0);
+            m_in->read_bytes(v.data(), n);
+        }
+
+        // a block is only read once all values of the previous block
+        // have been decoded
+        inline void read_block() {
+            DCHECK(block_done());
+
+            const size_t num_ints = m_in->read_compressed_int<size_t>();
+            const size_t num_literals = m_in->read_compressed_int<size_t>();
+            m_num_bits = m_in->read_compressed_int<size_t>();
+
+            std::vector<uint8_t> ctrl, data;
+            read_bytes(ctrl, idiv_ceil(num_ints, 4));
+            read_bytes(data, svbyte::data_length(ctrl.data(), num_ints), 16);
+
+            m_ints.resize(num_ints);
+            svbyte::decode(ctrl.data(), data.data(), num_ints, m_ints.data());
+
+            read_bytes(m_literals, num_literals);
+            read_bytes(m_bits, idiv_ceil(m_num_bits, 8));
+
+            m_int_pos = 0;
+            m_literal_pos = 0;
+            m_bit_pos = 0;
+        }
+
+        inline uint32_t next_int() {
+            if(m_int_pos == m_ints.size()) {
+                read_block();
+                if(m_ints.empty()) return 0; // EOF
+            }
+            return m_ints[m_int_pos++];
+        }
+
+    public:
+        DECODER_CTOR(env, in) {
+        }
+
+        inline bool eof() const {
+            return block_done() && m_in->eof();
+        }
+
+        template<typename value_t>
+        inline value_t decode(const Range& r) {
+            uint64_t x = next_int();
+            if(bits_for(r.delta()) > 32) x |= uint64_t(next_int()) << 32;
+            return value_t(x + r.min());
+        }
+
+        template<typename value_t>
+        inline value_t decode(const LiteralRange&) {
+            if(m_literal_pos == m_literals.size()) {
+                read_block();
+                if(m_literals.empty()) return value_t(0); // EOF
+            }
+            return value_t(m_literals[m_literal_pos++]);
+        }
+
+        template<typename value_t>
+        inline value_t decode(const BitRange&) {
+            if(m_bit_pos == m_num_bits) {
+                read_block();
+                if(m_num_bits == 0) return value_t(0); // EOF
+            }
+            const size_t i = m_bit_pos++;
+            return value_t((m_bits[i / 8] >> (i % 8)) & 1);
+        }
+
+        template<typename value_t, typename range_t>
+        inline void decode_many(value_t* out, size_t n, const range_t& r) {
+            for(size_t i = 0; i < n; ++i) out[i] = decode<value_t>(r);
+        }
+    };
+};
+
+}
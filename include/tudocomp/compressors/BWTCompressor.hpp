@@ -1,15 +1,37 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 #include <tudocomp/util.hpp>
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/ds/bwt.hpp>
 #include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/util/divsufsort.hpp>
+#include <tudocomp/util/parallel.hpp>
 #include <tudocomp/util.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
 
 namespace tdc {
 
+/// Computes the Burrows-Wheeler transform of the text.
+///
+/// If the option `samples` is set to k > 0, the positions of every
+/// (n / k)-th suffix in the suffix array are appended to the BWT. The
+/// decoder uses them to invert k segments of the BWT concurrently with
+/// the amount of threads given by the option `threads`.
+///
+/// The samples are written as 64-bit words in host byte order, followed by
+/// the sampling distance and the amount of samples.
+///
+/// With the default suffix array provider and the option `direct` set,
+/// the BWT is constructed directly by divsufsort in a work buffer of n
+/// integers. This bypasses the text data structures, so their options
+/// (such as `cache`, `compress` and `storage`) have no effect.
 template<typename text_t = TextDS<>>
 class BWTCompressor : public Compressor {
 
@@ -20,6 +42,9 @@ public:
     inline static Meta meta() {
         Meta m("compressor", "bwt", "BWT Compressor");
         m.option("textds").templated<text_t, TextDS<>>("textds");
+        m.option("samples").dynamic(0);
+        m.option("threads").dynamic(0);
+        m.option("direct").dynamic(true);
         m.uses_textds<text_t>(ds::SA);
         return m;
     }
@@ -31,28 +56,164 @@ public:
         auto in = input.as_view();
         DCHECK(in.ends_with(uint8_t(0)));
 
+        const size_t input_size = in.size();
+        const size_t samples = env().option("samples").as_integer();
+
+        // the suffixes at multiples of step are sampled, except the first
+        // and the last one
+        const size_t k = std::max(samples, size_t(1));
+        const size_t step = std::max((input_size + k - 1) / k, size_t(1));
+        std::vector<len_t> rows;
+        if(samples > 0 && input_size >= 2) rows.resize((input_size - 2) / step);
+
+        if(env().option("direct").as_bool() &&
+                std::is_same<typename text_t::sa_type, SADivSufSort>::value) {
+            compress_direct(in, ostream, step, rows);
+        } else {
+            compress_textds(in, ostream, step, rows);
+        }
+
+        if(samples > 0) {
+            StatPhase::wrap("Output Samples", [&]{
+                for(auto row : rows) write_word(ostream, row);
+                write_word(ostream, step);
+                write_word(ostream, rows.size());
+            });
+        }
+    }
+
+private:
+    inline static void write_word(std::ostream& ostream, uint64_t x) {
+        ostream.write((const char*) &x, sizeof(x));
+    }
+
+    inline static uint64_t read_word(const View& in, size_t i) {
+        uint64_t x;
+        memcpy(&x, in.data() + i, sizeof(x));
+        return x;
+    }
+
+    // with divsufsort, the BWT is constructed directly in a work buffer
+    // of n integers, which is packed to n bytes in place
+    inline void compress_direct(View in, std::ostream& ostream,
+                                size_t step, std::vector<len_t>& rows) {
+        const size_t input_size = in.size();
+
+        std::vector<saidx_t> buffer;
+        const uliteral_t* bwt = StatPhase::wrap("Construct BWT", [&]{
+            buffer.resize(input_size);
+            const saidx_t pidx = divbwt(in.data(), buffer, input_size,
+                [&](saidx_t s, saidx_t i) {
+                    const size_t j = s / step;
+                    if(size_t(s) % step == 0 && j <= rows.size()) rows[j - 1] = i;
+                });
+            DCHECK_GE(pidx, 0);
+
+            uliteral_t* bytes = (uliteral_t*) buffer.data();
+            for(size_t i = 0; i < input_size; ++i) {
+                bytes[i] = uliteral_t(buffer[i]);
+            }
+            StatPhase::log("primary_index", size_t(pidx));
+            return bytes;
+        });
+
+        StatPhase::wrap("Output BWT", [&]{
+            ostream.write((const char*) bwt, input_size);
+        });
+    }
+
+    // other suffix array providers go through the text data structures,
+    // the BWT is flushed in blocks
+    inline void compress_textds(View in, std::ostream& ostream,
+                                size_t step, std::vector<len_t>& rows) {
         text_t t(env().env_for_option("textds"), in, text_t::SA);
-		DVLOG(2) << vec_to_debug_string(t);
-		const len_t input_size = t.size();
+        DVLOG(2) << vec_to_debug_string(t);
+        const len_t input_size = t.size();
 
         StatPhase::wrap("Construct Text DS", [&]{
             t.require(text_t::SA);
             DVLOG(2) << vec_to_debug_string(t.require_sa());
         });
 
-        const auto& sa = t.require_sa();
-        for(size_t i = 0; i < input_size; ++i) {
-            ostream << bwt::bwt(t,sa,i);
-        }
+        StatPhase::wrap("Output BWT", [&]{
+            const auto& sa = t.require_sa();
+
+            static constexpr size_t BLOCK_SIZE = 1ULL << 16;
+            char block[BLOCK_SIZE];
+            size_t i = 0, m = 0;
+            for_each_entry(sa, [&](uint64_t s) {
+                const size_t j = s / step;
+                if(s % step == 0 && j > 0 && j <= rows.size()) rows[j - 1] = i;
+                ++i;
+
+                block[m++] = (s == 0) ? t[input_size - 1] : t[s - 1];
+                if(m == BLOCK_SIZE) {
+                    ostream.write(block, m);
+                    m = 0;
+                }
+            });
+            ostream.write(block, m);
+        });
     }
 
+    // calls f(value) for all entries of the suffix array in order, decoding
+    // bit packed arrays in blocks
+    template<typename sa_t, typename F>
+    inline static void for_each_entry(const sa_t& sa, F f) {
+        for_each_entry(sa, f, std::is_base_of<DynamicIntVector, sa_t>());
+    }
+
+    template<typename sa_t, typename F>
+    inline static void for_each_entry(const sa_t& sa, F f, std::true_type) {
+        sa.for_each(f);
+    }
+
+    template<typename sa_t, typename F>
+    inline static void for_each_entry(const sa_t& sa, F f, std::false_type) {
+        for(size_t i = 0; i < sa.size(); ++i) f(uint64_t(sa[i]));
+    }
+
+public:
     inline virtual void decompress(Input& input, Output& output) override {
         auto in = input.as_view();
         auto ostream = output.as_stream();
 
-		uliteral_t* decoded_string = StatPhase::wrap("Decode BWT", [&]{
-            return bwt::decode_bwt(in);
-        });
+        uliteral_t* decoded_string;
+        if(env().option("samples").as_integer() > 0) {
+            if(in.size() < 16) {
+                throw std::runtime_error("corrupted compressed file");
+            }
+            const size_t count = read_word(in, in.size() - 8);
+            const size_t step = read_word(in, in.size() - 16);
+            if(step == 0 || count > (in.size() - 16) / 8) {
+                throw std::runtime_error("corrupted compressed file");
+            }
+            const size_t bwt_length = in.size() - 16 - 8 * count;
+            if(count != ((bwt_length >= 2) ? (bwt_length - 2) / step : 0)) {
+                throw std::runtime_error("corrupted compressed file");
+            }
+
+            std::vector<len_t> rows(count);
+            for(size_t j = 0; j < count; ++j) {
+                const uint64_t row = read_word(in, bwt_length + 8 * j);
+                if(row >= bwt_length) {
+                    throw std::runtime_error("corrupted compressed file");
+                }
+                rows[j] = row;
+            }
+
+            const size_t threads = parallel::num_threads(
+                env().option("threads").as_integer());
+
+            decoded_string = StatPhase::wrap("Decode BWT", [&]{
+                return bwt::decode_bwt_sampled(
+                    in.substr(0, bwt_length), rows, step, threads);
+            });
+        } else {
+            decoded_string = StatPhase::wrap("Decode BWT", [&]{
+                return bwt::decode_bwt(in);
+            });
+        }
 
 		if(tdc_unlikely(decoded_string == nullptr)) {
 			return;
@@ -3,6 +3,7 @@
 #include <tudocomp/Compressor.hpp>
 #include <tudocomp/compressors/lz78/LZ78Trie.hpp>
 #include <tudocomp/Range.hpp>
+#include <tudocomp/util/Allocator.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
 
@@ -14,28 +15,62 @@ namespace tdc {
 	}
 
     namespace lz78 {
+        /// Decodes LZ78 factors by copying.
+        ///
+        /// The decoded text is kept in a contiguous buffer along with the
+        /// starting position of each factor in it. Factor i is then the copy
+        /// of the factor it refers to followed by its literal. The buffer is
+        /// written to the output in chunks of \ref FLUSH_SIZE bytes and by
+        /// \ref flush.
         class Decompressor {
-            std::vector<lz78::factorid_t> indices;
-            std::vector<uliteral_t> literals;
+            alloc::Heap m_alloc;
+            uliteral_t* m_text = nullptr;
+            size_t m_size = 0;
+            size_t m_capacity = 0;
+            size_t m_flushed = 0;
+
+            std::vector<len_compact_t> m_starts; // starting position of each factor
 
             public:
+            /// The amount of decoded bytes written to the output at once.
+            static constexpr size_t FLUSH_SIZE = size_t(1) << 20;
+
+            inline Decompressor() = default;
+            Decompressor(const Decompressor&) = delete;
+            Decompressor& operator=(const Decompressor&) = delete;
+
+            inline ~Decompressor() {
+                m_alloc.deallocate(m_text, m_capacity);
+            }
+
             inline void decompress(lz78::factorid_t index, uliteral_t literal, std::ostream& out) {
-                indices.push_back(index);
-                literals.push_back(literal);
-                std::vector<uliteral_t> buffer;
-
-                while(index != 0) {
-                    buffer.push_back(literal);
-                    literal = literals[index - 1];
-                    index = indices[index - 1];
+                DCHECK_LE(index, m_starts.size());
+
+                // the referred factor ends where its successor starts
+                const size_t src = (index > 0) ? size_t(len_t(m_starts[index - 1])) : 0;
+                const size_t len = (index > 0)
+                    ? ((index < m_starts.size()) ? size_t(len_t(m_starts[index])) : m_size) - src
+                    : 0;
+
+                if(m_size + len + 1 > m_capacity) {
+                    const size_t capacity = std::max(2 * m_capacity, m_size + len + 1);
+                    m_text = m_alloc.reallocate(m_text, m_capacity, capacity);
+                    m_capacity = capacity;
                 }
 
-                out << literal;
-                for(size_t i = buffer.size(); i > 0; i--) {
-                    out << buffer[i - 1];
-                }
+                m_starts.push_back(m_size);
+                std::memcpy(m_text + m_size, m_text + src, len);
+                m_text[m_size + len] = literal;
+                m_size += len + 1;
+
+                if(m_size - m_flushed >= FLUSH_SIZE) flush(out);
             }
 
+            /// Writes the bytes decoded since the last flush to the output.
+            inline void flush(std::ostream& out) {
+                out.write((const char*) m_text + m_flushed, m_size - m_flushed);
+                m_flushed = m_size;
+            }
         };
     }//ns
 
@@ -163,6 +198,7 @@ public:
             factor_count++;
         }
 
+        decomp.flush(out);
         out.flush();
     }
 
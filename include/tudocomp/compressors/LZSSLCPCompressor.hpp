@@ -57,10 +57,16 @@ public:
         const len_t text_length = text.size();
         lzss::FactorBuffer factors;
 
+        // collect statistics for the encoder during factorization
+        Statistics stats;
+        FieldStatistics& fdist = stats.field(lzss::FDIST_FIELD);
+
         StatPhase::wrap("Factorize", [&]{
             const len_t threshold = env().option("threshold").as_integer(); //factor threshold
 
-            for(len_t i = 0; i+1 < text_length;) { // we omit T[text_length-1] since we assume that it is the \0 byte!
+            len_t i = 0;
+            size_t run = 0; // length of the current literal run
+            for(; i+1 < text_length;) { // we omit T[text_length-1] since we assume that it is the \0 byte!
                 //get SA position for suffix i
                 const size_t& cur_pos = isa[i];
 			    DCHECK_NE(cur_pos,0); // isa[i] == 0 <=> T[i] = 0
@@ -103,22 +109,33 @@ public:
 				    DCHECK_GE(max_pos, 0);
                     // new factor
                     factors.emplace_back(i, sa[max_pos], max_lcp);
+                    fdist.add(run);
+                    run = 0;
 
                     i += max_lcp; //advance
                 } else {
+                    stats.add_literal(text[i]);
+                    ++run;
                     ++i; //advance
                 }
             }
 
+            // the remainder (at least the \0 byte) consists of literals
+            for(; i < text_length; ++i) {
+                stats.add_literal(text[i]);
+                ++run;
+            }
+            fdist.add(run);
+
             StatPhase::log("threshold", threshold);
             StatPhase::log("factors", factors.size());
         });
 
         // encode
         typename coder_t::Encoder coder(env().env_for_option("coder"),
-            output, lzss::TextLiterals<text_t>(text, factors));
+            output, with_statistics(lzss::TextLiterals<text_t>(text, factors), stats));
 
-        lzss::encode_text(coder, text, factors); //TODO is this correct?
+        lzss::encode_text(coder, text, factors, stats);
     }
 
     inline virtual void decompress(Input& input, Output& output) override {
@@ -20,9 +20,6 @@ namespace lcpcomp {
  * In the latter case, we push it down to the respective array
  */
 class ArraysComp : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     inline static Meta meta() {
         Meta m("lcpcomp_comp", "arrays");
@@ -30,33 +27,39 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
     using Algorithm::Algorithm; //import constructor
 
+    template<typename text_t>
     inline void factorize(text_t& text, size_t threshold, lzss::FactorBuffer& factors) {
 
 		// Construct SA, ISA and LCP
+        // the LCP array is modified, so its data is taken over
+        len_t max_lcp = 0;
         auto lcp = StatPhase::wrap("Construct Index Data Structures", [&] {
             text.require(text_t::SA | text_t::ISA | text_t::LCP);
 
-            auto lcp = text.release_lcp();
-            StatPhase::log("maxlcp", lcp.max_lcp());
-            return lcp;
+            auto lcp_ds = text.release_lcp();
+            max_lcp = lcp_ds.max_lcp();
+            StatPhase::log("maxlcp", max_lcp);
+            return lcp_ds.relinquish();
         });
 
         auto& sa = text.require_sa();
         auto& isa = text.require_isa();
 
-        if(lcp.max_lcp()+1 <= threshold) return; // nothing to factorize
-        const size_t cand_length = lcp.max_lcp()+1-threshold;
+        if(max_lcp+1 <= threshold) return; // nothing to factorize
+        const size_t cand_length = max_lcp+1-threshold;
         std::vector<len_t>* cand = new std::vector<len_t>[cand_length];
 
         StatPhase::wrap("Fill candidates", [&]{
+            int_vector::ChunkedReader<dynamic_t> reader(lcp, 1);
             for(size_t i = 1; i < sa.size(); ++i) {
-                if(lcp[i] < threshold) continue;
-                cand[lcp[i]-threshold].push_back(i);
+                const size_t l = reader.next();
+                if(l < threshold) continue;
+                cand[l-threshold].push_back(i);
             }
 
             StatPhase::log("entries", [&] () {
@@ -69,9 +72,9 @@ public:
 
         StatPhase::wrap("Compute Factors", [&]{
             StatPhase phase(std::string{"Factors at max. LCP value "}
-                + std::to_string(lcp.max_lcp()));
+                + std::to_string(max_lcp));
 
-            for(size_t maxlcp = lcp.max_lcp(); maxlcp >= threshold; --maxlcp) {
+            for(size_t maxlcp = max_lcp; maxlcp >= threshold; --maxlcp) {
                 IF_STATS({
                     const len_t maxlcpbits = bits_for(maxlcp-threshold);
                     if( ((maxlcpbits ^ (1UL<<(bits_for(maxlcpbits)-1))) == 0) && (( (maxlcp-threshold) ^ (1UL<<(maxlcpbits-1))) == 0)) { // only log at certain LCP values
@@ -22,9 +22,6 @@ namespace lcpcomp {
 /// This was the original naive approach in "Textkompression mithilfe von
 /// Enhanced Suffix Arrays" (BA thesis, Patrick Dinklage, 2015).
 class BoostHeap : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     inline static Meta meta() {
         Meta m("lcpcomp_comp", "bheap", "boost heaps");
@@ -32,11 +29,12 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
     using Algorithm::Algorithm; //import constructor
 
+    template<typename text_t>
     inline void factorize(text_t& text, const size_t threshold, lzss::FactorBuffer& factors) {
 
 		// Construct SA, ISA and LCP
@@ -48,7 +46,7 @@ public:
         auto& isa = text.require_isa();
 
         text.require_lcp();
-        auto lcp = text.release_lcp();
+        auto lcp = text.release_lcp().relinquish();
 
 		struct LCPCompare {
 			using lcp_t = decltype(lcp);
@@ -20,9 +20,6 @@ namespace lcpcomp {
 /// This was the original naive approach in "Textkompression mithilfe von
 /// Enhanced Suffix Arrays" (BA thesis, Patrick Dinklage, 2015).
 class MaxLCPStrategy : public Algorithm {
-private:
-    typedef TextDS<> text_t;
-
 public:
     inline static Meta meta() {
         Meta m("lcpcomp_comp", "max_lcp");
@@ -30,11 +27,12 @@ public:
     }
 
     inline static ds::dsflags_t textds_flags() {
-        return text_t::SA | text_t::ISA | text_t::LCP;
+        return ds::SA | ds::ISA | ds::LCP;
     }
 
     using Algorithm::Algorithm; //import constructor
 
+    template<typename text_t>
     inline void factorize(text_t& text,
                    size_t threshold,
                    lzss::FactorBuffer& factors) {
@@ -48,11 +46,13 @@ public:
         auto& isa = text.require_isa();
 
         text.require_lcp();
-        auto lcp = text.release_lcp();
+        auto lcp_ds = text.release_lcp();
+        const len_t max_lcp = lcp_ds.max_lcp();
+        auto lcp = lcp_ds.relinquish();
 
         auto list = StatPhase::wrap("Construct MaxLCPSuffixList", [&]{
-            MaxLCPSuffixList<text_t::lcp_type::data_type> list(
-                lcp, threshold, lcp.max_lcp());
+            MaxLCPSuffixList<typename text_t::lcp_type::data_type> list(
+                lcp, threshold, max_lcp);
 
             StatPhase::log("entries", list.size());
             return list;
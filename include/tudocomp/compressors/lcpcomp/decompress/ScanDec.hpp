@@ -1,11 +1,11 @@
 #pragma once
 
 #include <vector>
-#include <sdsl/int_vector.hpp>
-#include <sdsl/rank_support.hpp>
 #include <tudocomp/def.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/RankSelectBitVector.hpp>
 #include <tudocomp/Algorithm.hpp>
+#include <tudocomp/util/Allocator.hpp>
 #include <algorithm>
 
 #include <tudocomp_stat/StatPhase.hpp>
@@ -21,14 +21,15 @@ namespace lcpcomp {
 	 * to get decompressed.
 	 * The not-yet decoded positions are marked in a bit vector with rank-support
 	 * such that we can map from text position to positions in the array.
+	 * The arrays are allocated from a pool and freed in bulk at the end.
 	 */
 	class EagerScanDec {
 		Env& m_env;
 		IntVector<uliteral_t>& m_buffer;
-		const sdsl::bit_vector m_bv;
-		const sdsl::bit_vector::rank_1_type m_rank;
+		const RankSelectBitVector m_bv;
 		const len_t m_empty_entries;
-		len_t**const m_fwd = nullptr;
+		alloc::Pool m_pool;
+		len_compact_t**const m_fwd = nullptr;
 
 		IF_STATS(len_t m_longest_chain = 0);
 		IF_STATS(len_t m_current_chain = 0);
@@ -37,51 +38,50 @@ namespace lcpcomp {
 		EagerScanDec(Env& env, IntVector<uliteral_t>& buffer)
 			: m_env(env)
 			, m_buffer { buffer }
-			, m_bv ( [&buffer] () -> sdsl::bit_vector {
-				sdsl::bit_vector bv { buffer.size(),0 };
+			, m_bv ( [&buffer] () -> RankSelectBitVector {
+				RankSelectBitVector bv { buffer.size() };
 				for(len_t i = 0; i < buffer.size(); ++i) {
 					if(buffer[i]) continue;
-					bv[i] = 1;
+					bv.set(i);
 				}
+				bv.build();
 				return bv;
 			}() )
-			, m_rank { &m_bv }
-			//, m_empty_entries { static_cast<len_t>( buffer.size()) }
-			, m_empty_entries { static_cast<len_t>(std::count_if(buffer.cbegin(), buffer.cend(), [] (const uliteral_t& i) { return i == 0; })) }
-			, m_fwd { new len_t*[m_empty_entries+1] }
+			, m_empty_entries { static_cast<len_t>(m_bv.ones()) }
+			, m_fwd { new len_compact_t*[m_empty_entries+1] }
 		{
         std::fill(m_fwd,m_fwd+m_empty_entries,nullptr);
 		}
 
 		len_t rank(len_t i) const {
 			DCHECK(m_bv[i]);
-			return m_rank.rank(i+1);
+			return m_bv.rank1(i+1);
 		}
 
-		void decode(const std::vector<len_t>& m_target_pos, const std::vector<len_t>& m_source_pos, const std::vector<len_t>& m_length) {
+		void decode(const std::vector<len_compact_t>& m_target_pos, const std::vector<len_compact_t>& m_source_pos, const std::vector<len_compact_t>& m_length) {
             StatPhase phase("Decoding Factors");
 			const len_t factors = m_source_pos.size();
 			phase.log_stat("factors", factors);
 
 			for(len_t j = 0; j < factors; ++j) {
-				const len_t& target_position = m_target_pos[j];
-				const len_t& source_position = m_source_pos[j];
-				const len_t& factor_length = m_length[j];
+				const len_t target_position = m_target_pos[j];
+				const len_t source_position = m_source_pos[j];
+				const len_t factor_length = m_length[j];
 				for(len_t i = 0; i < factor_length; ++i) {
 					if(m_buffer[source_position+i]) {
 						decode_literal_at(target_position+i, m_buffer[source_position+i]);
 					} else {
 						DCHECK_EQ(m_bv[source_position+i],1);
-						len_t*& bucket = m_fwd[rank(source_position+i)];
+						len_compact_t*& bucket = m_fwd[rank(source_position+i)];
 						if(bucket == nullptr) {
-							bucket = new len_t[2];
+							bucket = m_pool.allocate<len_compact_t>(2);
 							bucket[0] = 2;
 							bucket[1] = target_position+i;
 						}
 						else
 						{ // this block implements the call of m_fwd[src]->push_back(m_cursor);
 							++bucket[0]; // increase the size of a bucket only by one!
-							bucket = (len_t*) realloc(bucket, sizeof(len_t)*bucket[0]);
+							bucket = m_pool.reallocate(bucket, bucket[0] - 1, bucket[0]);
 							bucket[bucket[0]-1] = target_position+i;
 						}
 					}
@@ -109,11 +109,11 @@ namespace lcpcomp {
 			const len_t rankpos = rank(pos);
 			DCHECK_LE(rankpos, m_empty_entries);
 			if(m_fwd[rankpos] != nullptr) {
-				const len_t*const& bucket = m_fwd[rankpos];
+				const len_compact_t*const& bucket = m_fwd[rankpos];
 				for(size_t i = 1; i < bucket[0]; ++i) {
 					decode_literal_at(bucket[i], c); // recursion
 				}
-				delete [] m_fwd[rankpos];
+				m_pool.deallocate(m_fwd[rankpos], bucket[0]);
 				m_fwd[rankpos] = nullptr;
 			}
 		}
@@ -128,10 +128,6 @@ namespace lcpcomp {
 
 	~EagerScanDec() {
 		DCHECK(m_fwd != nullptr);
-		for(size_t i = 0; i < m_empty_entries; ++i) {
-			if(m_fwd[i] == nullptr) continue;
-			delete [] m_fwd[i];
-		}
 		delete [] m_fwd;
 	}
 
@@ -177,9 +173,9 @@ private:
     inline void decode_lazy_() {
         const len_t factors = m_source_pos.size();
         for(len_t j = 0; j < factors; ++j) {
-            const len_t& target_position = m_target_pos[j];
-            const len_t& source_position = m_source_pos[j];
-            const len_t& factor_length = m_length[j];
+            const len_t target_position = m_target_pos[j];
+            const len_t source_position = m_source_pos[j];
+            const len_t factor_length = m_length[j];
             for(len_t i = 0; i < factor_length; ++i) {
 				//DCHECK(m_buffer[source_position+i] == 0 && m_buffer[target_position+i] == 0);
 				m_buffer[target_position+i] = m_buffer[source_position+i];
@@ -193,9 +189,9 @@ private:
 	IntVector<uliteral_t> m_buffer;
 
     //storing factors
-    std::vector<len_t> m_target_pos;
-    std::vector<len_t> m_source_pos;
-    std::vector<len_t> m_length;
+    std::vector<len_compact_t> m_target_pos;
+    std::vector<len_compact_t> m_source_pos;
+    std::vector<len_compact_t> m_length;
 
 	IF_STATS(len_t m_longest_chain = 0);
 
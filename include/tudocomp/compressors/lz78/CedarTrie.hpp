@@ -8,8 +8,8 @@
 
 namespace tdc {
 namespace lz78 {
-
-using cedar_factorid_t = lz78::factorid_t;
+// cedar stores values of at most 32 bits, which bounds the number of factors
+using cedar_factorid_t = uint32_t;
 using cedar_t = cedar::da<cedar_factorid_t>;
 
 const cedar_factorid_t CEDAR_NO_VALUE = static_cast<cedar_factorid_t>(cedar_t::error_code::CEDAR_NO_VALUE);
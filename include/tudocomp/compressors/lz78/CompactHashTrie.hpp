@@ -0,0 +1,259 @@
+#pragma once
+
+#include <unordered_map>
+
+#include <tudocomp/util.hpp>
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/compressors/lz78/LZ78Trie.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lz78 {
+
+/// \cond INTERNAL
+namespace compact {
+
+/// the multiplicative inverse of an odd number modulo 2^64 (Newton's method)
+inline constexpr uint64_t mul_inverse(uint64_t a, uint64_t x, size_t i) {
+    return i == 0 ? x : mul_inverse(a, x * (2 - a * x), i - 1);
+}
+
+constexpr uint64_t MUL_A = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t MUL_B = 0xBF58476D1CE4E5B9ULL;
+constexpr uint64_t INV_A = mul_inverse(MUL_A, MUL_A, 6);
+constexpr uint64_t INV_B = mul_inverse(MUL_B, MUL_B, 6);
+static_assert(MUL_A * INV_A == 1 && MUL_B * INV_B == 1, "no inverse");
+
+/// A bijective hash function on the integers with `bits` bits.
+/// Multiplications with odd numbers are invertible modulo a power of two,
+/// and a right shift by at least half of the bits is its own inverse.
+class BijectiveHash {
+    uint64_t m_mask;
+    size_t m_shift;
+
+public:
+    inline BijectiveHash(size_t bits)
+        : m_mask(bits >= 64 ? uint64_t(-1) : (1ULL << bits) - 1)
+        , m_shift((bits + 1) / 2) {}
+
+    inline uint64_t operator()(uint64_t x) const {
+        x = (x * MUL_A) & m_mask;
+        x ^= x >> m_shift;
+        return (x * MUL_B) & m_mask;
+    }
+
+    inline uint64_t inverse(uint64_t x) const {
+        x = (x * INV_B) & m_mask;
+        x ^= x >> m_shift;
+        return (x * INV_A) & m_mask;
+    }
+};
+
+} //ns compact
+/// \endcond
+
+/// A hash trie based on compact hashing in the style of Bonsai tries.
+///
+/// A node is the key `(parent, c)` of `w + 9` bits in a table of `2^w` slots,
+/// since the ids of the parents fit in `w + 1` bits. The key is hashed with a
+/// bijective function: the upper `w` bits of the hash are the initial
+/// address, and only the lower nine bits, the quotient, are stored. Collisions
+/// are resolved by linear probing, and each slot stores its distance to the
+/// initial address, so that the initial address and the quotient restore the
+/// key. Distances that do not fit into the slot are kept in a separate map.
+/// Together with the id of the node, a slot takes `w + 16` bits.
+///
+/// Root nodes are not stored in the table.
+class CompactHashTrie : public Algorithm, public LZ78Trie<factorid_t> {
+    static constexpr size_t QUOTIENT_BITS = 9;
+    static constexpr size_t DISP_BITS = 5;
+    static constexpr uint64_t DISP_OVERFLOW = (1ULL << DISP_BITS) - 1;
+    static constexpr size_t MIN_BITS = 8; // the roots have ids below 2^MIN_BITS
+
+    // a slot is the id of the node plus one, its displacement and its quotient
+    // an empty slot is zero
+    DynamicIntVector m_table;
+    std::unordered_map<size_t, size_t> m_displacements; // the overflowing displacements
+    size_t m_bits; // log2 of the table size
+    compact::BijectiveHash m_hash;
+    size_t m_entries = 0;
+    size_t m_max_entries = 0; // the number of entries before the table grows
+    size_t m_roots = 0;
+    const float m_load_factor;
+
+    IF_STATS(
+        size_t m_resizes = 0;
+        size_t m_fill_ups = 0;
+    )
+
+    inline void allocate(size_t bits) {
+        m_bits = bits;
+        m_hash = compact::BijectiveHash(bits + QUOTIENT_BITS);
+        m_table = DynamicIntVector(size_t(1) << bits, 0, uint8_t(bits + 2 + DISP_BITS + QUOTIENT_BITS));
+        m_displacements.clear();
+        // at least one slot stays empty, which ends every probe sequence
+        m_max_entries = std::min(size_t((size_t(1) << bits) * m_load_factor),
+                                 (size_t(1) << bits) - 1);
+    }
+
+    inline size_t displacement(size_t pos, uint64_t slot) const {
+        const uint64_t disp = (slot >> QUOTIENT_BITS) & DISP_OVERFLOW;
+        return disp == DISP_OVERFLOW ? m_displacements.at(pos) : disp;
+    }
+
+    inline void store(size_t pos, size_t disp, uint64_t quotient, factorid_t value) {
+        if(disp >= DISP_OVERFLOW) {
+            m_displacements[pos] = disp;
+            disp = DISP_OVERFLOW;
+        }
+        m_table[pos] = ((uint64_t(value) + 1) << (DISP_BITS + QUOTIENT_BITS))
+                     | (uint64_t(disp) << QUOTIENT_BITS) | quotient;
+    }
+
+    // stores a key that is not in the table
+    inline void insert(uint64_t key, factorid_t value) {
+        const uint64_t h = m_hash(key);
+        const size_t mask = m_table.size() - 1;
+        const size_t init = h >> QUOTIENT_BITS;
+        for(size_t disp = 0;; disp++) {
+            const size_t pos = (init + disp) & mask;
+            if(uint64_t(m_table[pos]) == 0) {
+                store(pos, disp, h & ((1ULL << QUOTIENT_BITS) - 1), value);
+                return;
+            }
+        }
+    }
+
+    inline void grow() {
+        IF_STATS(++m_resizes);
+        DynamicIntVector old;
+        old.swap(m_table);
+        std::unordered_map<size_t, size_t> old_displacements;
+        std::swap(old_displacements, m_displacements);
+        const compact::BijectiveHash old_hash = m_hash;
+        const size_t mask = old.size() - 1;
+
+        allocate(m_bits + 1);
+        for(size_t pos = 0; pos < old.size(); pos++) {
+            const uint64_t slot = old[pos];
+            if(slot == 0) continue;
+
+            uint64_t disp = (slot >> QUOTIENT_BITS) & DISP_OVERFLOW;
+            if(disp == DISP_OVERFLOW) disp = old_displacements.at(pos);
+            const uint64_t init = (pos - disp) & mask;
+            const uint64_t quotient = slot & ((1ULL << QUOTIENT_BITS) - 1);
+            const uint64_t key = old_hash.inverse((init << QUOTIENT_BITS) | quotient);
+            insert(key, (slot >> (DISP_BITS + QUOTIENT_BITS)) - 1);
+        }
+    }
+
+    // like HashMap, fills the table up to a load of 0.95 instead of growing
+    // it, if the expected remaining factors fit. The expectation is only
+    // used in the second half of the text, where it extrapolates the
+    // factors so far, since a table that grows anyway after filling up
+    // leaves more displacements in the side map.
+    inline bool fill_up() {
+        if(m_remaining_characters * 2 >= m_n) return false;
+
+        const size_t max_entries = std::min(size_t(m_table.size() * 0.95),
+                                            m_table.size() - 1);
+        const size_t expected = m_entries + 1 +
+            lz78_expected_number_of_remaining_elements(size(), m_n, m_remaining_characters);
+        if(m_max_entries < max_entries && expected <= max_entries) {
+            IF_STATS(++m_fill_ups);
+            m_max_entries = max_entries;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("lz78trie", "compact", "Hash Trie with compact hashing");
+        m.option("load_factor").dynamic(80);
+        return m;
+    }
+
+    inline CompactHashTrie(Env&& env, const size_t n, const size_t& remaining_characters, factorid_t reserve = 0)
+        : Algorithm(std::move(env))
+        , LZ78Trie(n,remaining_characters)
+        , m_hash(0)
+        , m_load_factor(this->env().option("load_factor").as_integer()/100.0f)
+    {
+        DCHECK_GT(m_load_factor, 0.0f);
+        size_t bits = MIN_BITS;
+        while((size_t(1) << bits) * m_load_factor < size_t(reserve)) {
+            ++bits;
+        }
+        allocate(bits);
+    }
+
+    IF_STATS(
+        MoveGuard m_guard;
+        inline ~CompactHashTrie() {
+            if (m_guard) {
+                StatPhase::log("resizes", m_resizes);
+                StatPhase::log("fill ups", m_fill_ups);
+                StatPhase::log("table size", m_table.size());
+                StatPhase::log("slot width", m_table.width());
+                StatPhase::log("load ratio", m_entries*100/m_table.size());
+                StatPhase::log("displacement overflows", m_displacements.size());
+            }
+        }
+    )
+    CompactHashTrie(CompactHashTrie&& other) = default;
+
+    inline node_t add_rootnode(uliteral_t) override {
+        DCHECK_EQ(m_entries, 0U) << "root nodes have to be added first";
+        DCHECK_LT(m_roots, size_t(1) << MIN_BITS);
+        ++m_roots;
+        return size() - 1;
+    }
+
+    inline node_t get_rootnode(uliteral_t c) override {
+        return c;
+    }
+
+    inline void clear() override {
+        allocate(m_bits);
+        m_entries = 0;
+        m_roots = 0;
+    }
+
+    inline node_t find_or_insert(const node_t& parent_w, uliteral_t c) override {
+        // the parent's id followed by the literal
+        const uint64_t key = (uint64_t(parent_w.id()) << 8) | c;
+        const uint64_t h = m_hash(key);
+        const uint64_t quotient = h & ((1ULL << QUOTIENT_BITS) - 1);
+
+        const size_t mask = m_table.size() - 1;
+        const size_t init = h >> QUOTIENT_BITS;
+        for(size_t disp = 0;; disp++) {
+            const size_t pos = (init + disp) & mask;
+            const uint64_t slot = m_table[pos];
+            if(slot == 0) {
+                //! if we add a new node, its index will be equal to the current size of the dictionary
+                const factorid_t newleaf_id = size();
+                if(m_entries + 1 > m_max_entries && !fill_up()) {
+                    grow();
+                    insert(key, newleaf_id);
+                } else {
+                    store(pos, disp, quotient, newleaf_id);
+                }
+                ++m_entries;
+                return undef_id;
+            }
+            if((slot & ((1ULL << QUOTIENT_BITS) - 1)) == quotient
+                    && displacement(pos, slot) == disp) {
+                return factorid_t((slot >> (DISP_BITS + QUOTIENT_BITS)) - 1);
+            }
+        }
+    }
+
+    inline factorid_t size() const override {
+        return m_roots + m_entries;
+    }
+};
+
+}} //ns
@@ -7,7 +7,7 @@
 namespace tdc {
 namespace lz78 {
 
-using factorid_t = std::uint32_t; //! type for the factor indices, bounded by the number of LZ78 trie nodes
+using factorid_t = len_t; //! type for the factor indices, bounded by the number of LZ78 trie nodes
 static constexpr factorid_t undef_id = std::numeric_limits<factorid_t>::max(); // for a non-existing factor
 
 /// Maximum legal dictionary size.
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <tudocomp/Algorithm.hpp>
+#include <tudocomp/util/Hash.hpp>
+#include <tudocomp/compressors/lz78/LZ78Trie.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace lz78 {
+
+/// \cond INTERNAL
+namespace swiss {
+
+#ifdef __AVX2__
+constexpr size_t GROUP_SIZE = 32;
+#else
+constexpr size_t GROUP_SIZE = 16;
+#endif
+
+/// the control byte of an empty slot, full slots store seven bits of the hash
+constexpr uint8_t EMPTY = 0x80;
+
+/// A group of slots, which is probed at once.
+struct Group {
+    uint8_t ctrl[GROUP_SIZE];
+    uint64_t keys[GROUP_SIZE];
+    factorid_t values[GROUP_SIZE];
+
+    /// yields a bit mask of the slots with control byte b
+    inline uint32_t match(uint8_t b) const {
+#if defined(__AVX2__)
+        const __m256i c = _mm256_loadu_si256((const __m256i*) ctrl);
+        return uint32_t(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(c, _mm256_set1_epi8(char(b)))));
+#elif defined(__SSE2__)
+        const __m128i c = _mm_loadu_si128((const __m128i*) ctrl);
+        return uint32_t(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(c, _mm_set1_epi8(char(b)))));
+#else
+        uint32_t m = 0;
+        for(size_t i = 0; i < GROUP_SIZE; i++) {
+            m |= uint32_t(ctrl[i] == b) << i;
+        }
+        return m;
+#endif
+    }
+};
+
+} //ns swiss
+/// \endcond
+
+/// A hash trie storing its nodes in a table in the style of Google's
+/// Swiss tables.
+///
+/// The slots of the table are partitioned into groups of 16 slots, or 32
+/// slots with `AVX2`. Each group stores one control byte per slot, followed
+/// by the keys and the values of its slots. A control byte is either empty
+/// or holds seven bits of the hash of the slot's key, so a probe compares
+/// the hash fragment against all control bytes of a group with a single
+/// `SSE2` or `AVX2` instruction and only looks at the keys of the matches.
+/// Groups are probed quadratically. Nodes are never removed, so the first
+/// group with an empty slot ends an unsuccessful search.
+///
+/// Root nodes are not stored in the table.
+class SwissTrie : public Algorithm, public LZ78Trie<factorid_t> {
+    using Group = swiss::Group;
+    static constexpr size_t GROUP_SIZE = swiss::GROUP_SIZE;
+
+    std::vector<Group> m_groups; // the number of groups is a power of two
+    size_t m_entries = 0;
+    size_t m_max_entries = 0; // the number of entries before the table grows
+    size_t m_roots = 0;
+    const float m_load_factor;
+
+    IF_STATS(
+        size_t m_resizes = 0;
+    )
+
+    // the parent's id followed by the literal
+    inline static uint64_t node_key(factorid_t parent, uliteral_t c) {
+        return (uint64_t(parent) << 8) | c;
+    }
+
+    inline static uint64_t hash(uint64_t key) {
+        return _VignaHasher()(key);
+    }
+
+    inline void allocate(size_t num_groups) {
+        DCHECK_EQ(num_groups & (num_groups - 1), 0U);
+        m_groups.assign(num_groups, Group());
+        for(Group& g : m_groups) std::memset(g.ctrl, swiss::EMPTY, GROUP_SIZE);
+        // at least one slot stays empty, which ends every probe sequence
+        m_max_entries = std::min(size_t(num_groups * GROUP_SIZE * m_load_factor),
+                                 num_groups * GROUP_SIZE - 1);
+    }
+
+    // stores a key that is not in the table
+    inline void insert(uint64_t key, uint64_t h, factorid_t value) {
+        const size_t mask = m_groups.size() - 1;
+        size_t g = h & mask;
+        for(size_t step = 1;; step++) {
+            Group& group = m_groups[g];
+            const uint32_t empty = group.match(swiss::EMPTY);
+            if(empty != 0) {
+                const size_t i = __builtin_ctz(empty);
+                group.ctrl[i] = uint8_t(h >> 57);
+                group.keys[i] = key;
+                group.values[i] = value;
+                return;
+            }
+            g = (g + step) & mask;
+        }
+    }
+
+    inline void grow() {
+        IF_STATS(++m_resizes);
+        std::vector<Group> old;
+        std::swap(old, m_groups);
+        allocate(2 * old.size());
+
+        for(const Group& group : old) {
+            for(size_t i = 0; i < GROUP_SIZE; i++) {
+                if(group.ctrl[i] != swiss::EMPTY) {
+                    insert(group.keys[i], hash(group.keys[i]), group.values[i]);
+                }
+            }
+        }
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("lz78trie", "swiss", "Hash Trie with SIMD probing");
+        m.option("load_factor").dynamic(87);
+        return m;
+    }
+
+    inline SwissTrie(Env&& env, const size_t n, const size_t& remaining_characters, factorid_t reserve = 0)
+        : Algorithm(std::move(env))
+        , LZ78Trie(n,remaining_characters)
+        , m_load_factor(this->env().option("load_factor").as_integer()/100.0f)
+    {
+        DCHECK_GT(m_load_factor, 0.0f);
+        size_t num_groups = 1;
+        while(num_groups * GROUP_SIZE * m_load_factor < size_t(reserve)) {
+            num_groups *= 2;
+        }
+        allocate(num_groups);
+    }
+
+    IF_STATS(
+        MoveGuard m_guard;
+        inline ~SwissTrie() {
+            if (m_guard) {
+                StatPhase::log("resizes", m_resizes);
+                StatPhase::log("table size", m_groups.size() * GROUP_SIZE);
+                StatPhase::log("load ratio", m_entries*100/(m_groups.size() * GROUP_SIZE));
+            }
+        }
+    )
+    SwissTrie(SwissTrie&& other) = default;
+
+    inline node_t add_rootnode(uliteral_t) override {
+        DCHECK_EQ(m_entries, 0U) << "root nodes have to be added first";
+        ++m_roots;
+        return size() - 1;
+    }
+
+    inline node_t get_rootnode(uliteral_t c) override {
+        return c;
+    }
+
+    inline void clear() override {
+        for(Group& g : m_groups) std::memset(g.ctrl, swiss::EMPTY, GROUP_SIZE);
+        m_entries = 0;
+        m_roots = 0;
+    }
+
+    inline node_t find_or_insert(const node_t& parent_w, uliteral_t c) override {
+        const uint64_t key = node_key(parent_w.id(), c);
+        const uint64_t h = hash(key);
+        const uint8_t fragment = uint8_t(h >> 57);
+
+        const size_t mask = m_groups.size() - 1;
+        size_t g = h & mask;
+        for(size_t step = 1;; step++) {
+            Group& group = m_groups[g];
+            for(uint32_t m = group.match(fragment); m != 0; m &= m - 1) {
+                const size_t i = __builtin_ctz(m);
+                if(group.keys[i] == key) return group.values[i];
+            }
+
+            const uint32_t empty = group.match(swiss::EMPTY);
+            if(empty != 0) {
+                //! if we add a new node, its index will be equal to the current size of the dictionary
+                const factorid_t newleaf_id = size();
+                if(m_entries + 1 > m_max_entries) {
+                    grow();
+                    insert(key, h, newleaf_id);
+                } else {
+                    const size_t i = __builtin_ctz(empty);
+                    group.ctrl[i] = fragment;
+                    group.keys[i] = key;
+                    group.values[i] = newleaf_id;
+                }
+                ++m_entries;
+                return undef_id;
+            }
+            g = (g + step) & mask;
+        }
+    }
+
+    inline factorid_t size() const override {
+        return m_roots + m_entries;
+    }
+};
+
+}} //ns
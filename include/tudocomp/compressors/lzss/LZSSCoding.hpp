@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include <tudocomp/Range.hpp>
+#include <tudocomp/Statistics.hpp>
 #include <tudocomp/compressors/lzss/LZSSFactors.hpp>
 #include <tudocomp/compressors/lzss/LZSSDecodeBackBuffer.hpp>
 //#include <tudocomp/compressors/lzss/LZSSDecodeForwardChainBuffer.hpp>
@@ -15,10 +16,17 @@
 namespace tdc {
 namespace lzss {
 
+/// Number of the \ref Statistics field holding the distances between
+/// factors, ie, the lengths of literal runs including the final one.
+constexpr size_t FDIST_FIELD = 0;
+
+/// Encodes a text given its factorization and the longest distance between
+/// two factors.
 template<typename coder_t, typename text_t>
 inline void encode_text(coder_t& coder,
                         const text_t& text,
-                        const FactorBuffer& factors) {
+                        const FactorBuffer& factors,
+                        size_t fdist_max) {
     assert(factors.is_sorted());
 
     auto n = text.size();
@@ -27,18 +35,6 @@ inline void encode_text(coder_t& coder,
     auto flen_min = factors.shortest_factor();
     auto flen_max = factors.longest_factor();
 
-    // determine longest distance between two factors
-    size_t fdist_max = 0;
-    {
-        size_t p = 0;
-        for(size_t i = 0; i < factors.size(); i++) {
-            fdist_max = std::max(fdist_max, factors[i].pos - p);
-            p = factors[i].pos + factors[i].len;
-        }
-
-        fdist_max = std::max(fdist_max, n - p);
-    }
-
     // define ranges
     Range text_r(n);
     MinDistributedRange flen_r(flen_min, flen_max);
@@ -77,7 +73,7 @@ inline void encode_text(coder_t& coder,
         coder.encode(f.src, text_r);
         coder.encode(f.len, flen_r);
 
-        p += f.len;
+        p += len_t(f.len);
     }
 
     if(p < n) {
@@ -91,6 +87,39 @@ inline void encode_text(coder_t& coder,
     }
 }
 
+/// Encodes a text given its factorization.
+template<typename coder_t, typename text_t>
+inline void encode_text(coder_t& coder,
+                        const text_t& text,
+                        const FactorBuffer& factors) {
+    assert(factors.is_sorted());
+
+    // determine longest distance between two factors
+    size_t fdist_max = 0;
+    {
+        size_t p = 0;
+        for(size_t i = 0; i < factors.size(); i++) {
+            fdist_max = std::max(fdist_max, factors[i].pos - p);
+            p = factors[i].pos + factors[i].len;
+        }
+
+        fdist_max = std::max(fdist_max, text.size() - p);
+    }
+
+    encode_text(coder, text, factors, fdist_max);
+}
+
+/// Encodes a text given its factorization and the statistics collected
+/// during factorization.
+template<typename coder_t, typename text_t>
+inline void encode_text(coder_t& coder,
+                        const text_t& text,
+                        const FactorBuffer& factors,
+                        const Statistics& stats) {
+    DCHECK_GT(stats.field(FDIST_FIELD).count(), 0);
+    encode_text(coder, text, factors, stats.field(FDIST_FIELD).max());
+}
+
 template<typename coder_t, typename decode_buffer_t>
 inline void decode_text(coder_t& decoder, std::ostream& outs) {
     // decode text range
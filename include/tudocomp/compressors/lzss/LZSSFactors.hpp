@@ -7,7 +7,8 @@ namespace lzss {
 
 class Factor {
 public:
-    len_t pos, src, len;
+    // stored in LEN_BITS bits each, so factors of large inputs take 15 bytes
+    len_compact_t pos, src, len;
 
     inline Factor(len_t fpos, len_t fsrc, len_t flen)
         : pos(fpos), src(fsrc), len(flen) {
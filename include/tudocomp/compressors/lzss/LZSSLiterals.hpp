@@ -17,7 +17,7 @@ private:
 
     inline void skip_factors() {
         while(m_next_factor < m_factors->size() && m_pos == (*m_factors)[m_next_factor].pos) {
-            m_pos += (*m_factors)[m_next_factor++].len;
+            m_pos += len_t((*m_factors)[m_next_factor++].len);
         }
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <tudocomp/util.hpp>
+#include <tudocomp/util/Allocator.hpp>
 #include <tudocomp/compressors/lz78/LZ78Trie.hpp>
 #include <tudocomp/compressors/lzw/LZWFactor.hpp>
 
@@ -9,47 +10,114 @@ namespace lzw {
 
 using CodeType = lz78::factorid_t;
 
-template<class F>
-void decode_step(F next_code_callback,
-                 std::ostream& out,
-                 const CodeType dms,
-                 const CodeType reserve_dms) {
-    std::vector<std::pair<CodeType, uliteral_t>> dictionary;
+/// Decodes LZW codes by copying the strings they refer to from the decoded text.
+///
+/// The string of code `ULITERAL_MAX + 1 + j` is the `j`-th factor since the
+/// last dictionary reset followed by the first character of its successor,
+/// which is exactly the text starting where the `j`-th factor starts
+/// and ending with the first character of its successor. Hence, only the
+/// starting position of each factor is stored.
+class Decoder {
+    alloc::Heap m_alloc;
+    uliteral_t* m_text = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    size_t m_flushed = 0;
+
+    std::vector<len_compact_t> m_starts; // starting position of each factor since the last reset
+
+    // copies len bytes from src to dst > src, where the ranges may overlap
+    inline static void copy(uliteral_t* dst, const uliteral_t* src, size_t len) {
+        // the copied text is periodic with period dst - src,
+        // so the copied prefix can be doubled in each step
+        while(len > 0) {
+            const size_t n = std::min(len, size_t(dst - src));
+            std::memcpy(dst, src, n);
+            dst += n;
+            len -= n;
+        }
+    }
 
-    // "named" lambda function, used to reset the dictionary to its initial contents
-    const auto reset_dictionary = [&] {
-        dictionary.clear();
-        dictionary.reserve(reserve_dms);
+public:
+    /// The amount of decoded bytes written to the output at once.
+    static constexpr size_t FLUSH_SIZE = size_t(1) << 20;
 
-        const long int minc = std::numeric_limits<uliteral_t>::min();
-        const long int maxc = std::numeric_limits<uliteral_t>::max();
+    inline Decoder(size_t reserve = 0) {
+        m_capacity = reserve;
+        if(m_capacity > 0) m_text = m_alloc.allocate<uliteral_t>(m_capacity);
+    }
 
-        for (long int c = minc; c <= maxc; ++c)
-            dictionary.push_back({dms, static_cast<uliteral_t> (c)});
-    };
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
 
-    const auto rebuild_string = [&](CodeType k) -> const std::vector<uliteral_t> * {
-        static std::vector<uliteral_t> s; // String
+    inline ~Decoder() {
+        m_alloc.deallocate(m_text, m_capacity);
+    }
 
-        s.clear();
+    /// Decodes the next code.
+    inline void decode(CodeType code, std::ostream& out) {
+        const size_t k = code;
 
-        // the length of a string cannot exceed the dictionary's number of entries
-        s.reserve(reserve_dms);
+        // the dictionary has an entry for each factor but the last one,
+        // and the code may refer to the entry added by itself (the KwKwK case)
+        if (k >= ULITERAL_MAX + 1 + m_starts.size()) {
+            std::stringstream s;
+            s << "invalid compressed code " << k;
+            throw std::runtime_error(s.str());
+        }
 
-        while (k != dms)
-        {
-            s.push_back(dictionary[k].second);
-            k = dictionary[k].first;
+        size_t src = 0;
+        size_t len = 1;
+        if(k > ULITERAL_MAX) {
+            const size_t j = k - (ULITERAL_MAX + 1);
+            src = len_t(m_starts[j]);
+            len = ((j + 1 < m_starts.size()) ? size_t(len_t(m_starts[j + 1])) : m_size) - src + 1;
+        }
+
+        if(m_size + len > m_capacity) {
+            const size_t capacity = std::max(2 * m_capacity, m_size + len);
+            m_text = m_alloc.reallocate(m_text, m_capacity, capacity);
+            m_capacity = capacity;
         }
 
-        std::reverse(s.begin(), s.end());
-        return &s;
-    };
+        m_starts.push_back(m_size);
+        if(k > ULITERAL_MAX) {
+            copy(m_text + m_size, m_text + src, len);
+        } else {
+            m_text[m_size] = static_cast<uliteral_t>(k);
+        }
+        m_size += len;
 
-    reset_dictionary();
+        if(m_size - m_flushed >= FLUSH_SIZE) flush(out);
+    }
+
+    /// Resets the dictionary to its initial contents.
+    ///
+    /// The strings of the new entries start after the text decoded so far,
+    /// so it is written to the output and dropped.
+    inline void reset(std::ostream& out) {
+        flush(out);
+        m_size = 0;
+        m_flushed = 0;
+        m_starts.clear();
+    }
+
+    /// Writes the bytes decoded since the last flush to the output.
+    inline void flush(std::ostream& out) {
+        out.write((const char*) m_text + m_flushed, m_size - m_flushed);
+        m_flushed = m_size;
+    }
+};
+
+template<class F>
+void decode_step(F next_code_callback,
+                 std::ostream& out,
+                 const CodeType dms,
+                 const CodeType reserve_dms) {
+    Decoder decoder(reserve_dms);
 
-    CodeType i {dms}; // Index
     CodeType k; // Key
+    size_t codes = 0; // number of codes since the last reset
 
     bool corrupted = false;
 
@@ -57,42 +125,22 @@ void decode_step(F next_code_callback,
     {
         bool dictionary_reset = false;
 
-        // dictionary's maximum size was reached
-        if (dictionary.size() == dms)
+        // the encoder adds an entry for each code, and resets its
+        // dictionary as soon as it has reached the maximum size
+        if (codes > 0 && codes + ULITERAL_MAX + 1 == size_t(dms))
         {
-            reset_dictionary();
+            decoder.reset(out);
+            codes = 0;
             dictionary_reset = true;
         }
 
         if (!next_code_callback(k, dictionary_reset, corrupted))
             break;
 
-        //std::cout << byte_to_nice_ascii_char(k) << "\n";
-
-        if (k > dictionary.size()) {
-            std::stringstream s;
-            s << "invalid compressed code " << k;
-            throw std::runtime_error(s.str());
-        }
-
-        const std::vector<uliteral_t> *s; // String
-
-        if (k == dictionary.size())
-        {
-            dictionary.push_back({i, rebuild_string(i)->front()});
-            s = rebuild_string(k);
-        }
-        else
-        {
-            s = rebuild_string(k);
-
-            if (i != dms)
-                dictionary.push_back({i, s->front()});
-        }
-
-        out.write((char*) &s->front(), s->size());
-        i = k;
+        decoder.decode(k, out);
+        ++codes;
     }
+    decoder.flush(out);
 
     if (corrupted)
         throw std::runtime_error("corrupted compressed file");
@@ -53,16 +53,46 @@
     #define IF_STATS(x) x
 #endif
 
+// width of text positions (default 32)
+// (pass -DLEN_BITS=40 or -DLEN_BITS=64 to CMake for inputs of 4 GiB and more)
+#ifndef LEN_T_BITS
+    /// The width of text positions, one of 32, 40 or 64.
+    #define LEN_T_BITS 32
+#endif
+
+#if LEN_T_BITS != 32 && LEN_T_BITS != 40 && LEN_T_BITS != 64
+    #error "LEN_T_BITS must be 32, 40 or 64"
+#endif
+
 namespace tdc {
     /// Type to represent input lengths.
+    ///
+    /// This is a native integer type. With 40 bit positions, it is 64 bits
+    /// wide, but positions are stored in 40 bits (see \ref LEN_BITS and
+    /// \ref len_compact_t).
+#if LEN_T_BITS > 32
+	typedef uint64_t len_t;
+#else
 	typedef uint32_t len_t;
+#endif
 
-    /// The maximum value of \ref len_t.
-	constexpr size_t LEN_MAX = std::numeric_limits<len_t>::max();
+    /// The amount of bits used to store a value of type \ref len_t.
+    ///
+    /// Uncompressed text data structures and stored positions use this
+    /// width, which is less than that of \ref len_t with 40 bit positions.
+    constexpr size_t LEN_BITS = LEN_T_BITS;
 
-    /// The amount of bits required to store the binary representation of a
-    /// value of type \ref len_t.
-    constexpr size_t LEN_BITS = 8 * sizeof(len_t);
+    /// The maximum value of \ref len_t, and thus the maximum input length.
+	constexpr size_t LEN_MAX = (LEN_BITS < 64)
+        ? (size_t(1) << LEN_BITS) - 1 : std::numeric_limits<len_t>::max();
+
+    /// Type to store values of type \ref len_t in \ref LEN_BITS bits, for
+    /// large amounts of positions held in memory.
+    ///
+    /// With 40 bit positions, this is the packed \ref uint_t<40>, otherwise
+    /// it equals \ref len_t.
+    typedef std::conditional<(LEN_BITS == 8 * sizeof(len_t)),
+        len_t, uint_t<LEN_BITS>>::type len_compact_t;
 
     /// Type to represent signed single literals.
 	typedef char literal_t;
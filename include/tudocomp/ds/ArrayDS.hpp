@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include <tudocomp/ds/IntVector.hpp>
 #include <tudocomp/util.hpp>
 
@@ -27,6 +30,59 @@ protected:
         (iv_t&)(*this) = std::move(iv);
         IF_DEBUG(m_is_initialized = true;)
     }
+
+    /// \brief Restores the data structure from a previously constructed
+    ///        array.
+    ///
+    /// Providers that forward a constructor taking `(Env&&, iv_t&&)` to
+    /// this one can be restored from the cache of \ref TextDS.
+    inline ArrayDS(iv_t&& data) {
+        set_array(std::move(data));
+    }
+
+    /// \brief Yields the largest value in the storage, used to restore the
+    ///        maximum LCP value of a cached array.
+    inline len_t max_value() const {
+        len_t max = 0;
+        for_each([&](uint64_t x) {
+            max = std::max(max, len_t(x));
+        });
+        return max;
+    }
+
+    /// \brief Signed integer type used to access the storage as a native
+    ///        array.
+    using native_t = std::make_signed<len_t>::type;
+
+    /// \brief Calls `f(native_t* array)` with the storage viewed as a native
+    ///        array of signed integers.
+    ///
+    /// This is possible if the storage has the width of \ref len_t on a
+    /// little endian platform, where the bit packed layout equals that of
+    /// a native array. With 40 bit positions, uncompressed arrays are
+    /// narrower and thus never viewed as a native array.
+    ///
+    /// With 32 bit positions, the storage's 64 bit words are accessed as
+    /// narrower integers, which the compiler may assume not to alias them.
+    /// The pointer therefore escapes into compiler barriers before and after
+    /// \c f, so no access to the words is moved across \c f. No memory is
+    /// allocated, the array's initial contents are unspecified.
+    ///
+    /// \return \c true if \c f was called, \c false if the storage's layout
+    ///         differs from a native array.
+    template<typename F>
+    inline bool with_native_array(F f) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        if(width() == 8 * sizeof(len_t)) {
+            native_t* array = reinterpret_cast<native_t*>(data());
+            asm volatile("" : : "r"(array) : "memory");
+            f(array);
+            asm volatile("" : : "r"(array) : "memory");
+            return true;
+        }
+#endif
+        return false;
+    }
 public:
     inline ArrayDS() {}
     inline ArrayDS(const ArrayDS& other) = delete;
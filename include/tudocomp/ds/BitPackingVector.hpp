@@ -16,6 +16,8 @@
 #include <climits>
 
 #include <tudocomp/ds/IntPtr.hpp>
+#include <tudocomp/ds/IntVectorStorage.hpp>
+#include <tudocomp/ds/bitpacking.hpp>
 #include <tudocomp/ds/uint_t.hpp>
 #include <tudocomp/ds/dynamic_t.hpp>
 #include <tudocomp/util/IntegerBase.hpp>
@@ -41,8 +43,10 @@ namespace int_vector {
     struct BitPackingVectorBase<uint_t<N>> {
         typedef DynamicIntValueType internal_data_type;
         typedef uint_t<N>           value_type;
+        typedef std::vector<internal_data_type,
+            StorageAllocator<internal_data_type>> storage_type;
 
-        std::vector<internal_data_type> m_vec;
+        storage_type m_vec;
         uint64_t m_real_size;
 
         inline BitPackingVectorBase():
@@ -61,8 +65,10 @@ namespace int_vector {
     struct BitPackingVectorBase<dynamic_t> {
         typedef DynamicIntValueType internal_data_type;
         typedef dynamic_t           value_type;
+        typedef std::vector<internal_data_type,
+            StorageAllocator<internal_data_type>> storage_type;
 
-        std::vector<internal_data_type> m_vec;
+        storage_type m_vec;
         uint64_t m_real_size;
         uint8_t m_width;
 
@@ -151,7 +157,7 @@ namespace int_vector {
         inline explicit BitPackingVector(size_type n): BitPackingVector() {
             this->m_real_size = n;
             size_t converted_size = bits2backing(elem2bits(this->m_real_size));
-            this->m_vec = std::vector<internal_data_type>(converted_size);
+            this->m_vec = typename BitPackingVectorBase<T>::storage_type(converted_size);
             DCHECK_EQ(converted_size, this->m_vec.capacity());
         }
         inline BitPackingVector(size_type n, const value_type& val): BitPackingVector(n) {
@@ -365,6 +371,41 @@ namespace int_vector {
             return this->m_vec.data();
         }
 
+        /// Yields the storage of the elements, \c nullptr for the heap.
+        inline std::shared_ptr<const Storage> storage() const {
+            return this->m_vec.get_allocator().storage();
+        }
+
+        /// Decodes the elements [first, first + n) into out.
+        ///
+        /// Elements are decoded a block of bulk::BLOCK at a time.
+        inline void unpack(size_type first, size_type n, uint64_t* out) const {
+            DCHECK_LE(first + n, size());
+            const uint8_t w = this->width();
+            const uint64_t* in = this->m_vec.data();
+
+            // elements before the first full block
+            if (n > 0 && first % bulk::BLOCK != 0) {
+                const size_t skip = first % bulk::BLOCK;
+                const size_t k = std::min(bulk::BLOCK - skip, n);
+
+                uint64_t buf[bulk::BLOCK];
+                bulk::unpack(in + (first / bulk::BLOCK) * w, w, buf, skip + k);
+                std::copy(buf + skip, buf + skip + k, out);
+                first += k;
+                out += k;
+                n -= k;
+            }
+            for (; n >= bulk::BLOCK; n -= bulk::BLOCK) {
+                bulk::unpack(in + (first / bulk::BLOCK) * w, w, out);
+                first += bulk::BLOCK;
+                out += bulk::BLOCK;
+            }
+            if (n > 0) {
+                bulk::unpack(in + (first / bulk::BLOCK) * w, w, out, n);
+            }
+        }
+
         template <class InputIterator>
         inline void assign(InputIterator first, InputIterator last) {
             *this = BitPackingVector(first, last);
@@ -537,41 +578,18 @@ namespace int_vector {
             if (old_width < new_width) {
                 // grow
 
-                // Read from position of last element in the old width grid,
-                // and write to position of last element in the new width grid
-                auto old_p = bitpos2backingpos_w(elem2bits_w(common_size, old_width));
-                auto new_p = bitpos2backingpos_w(elem2bits_w(common_size, new_width));
-
                 // make room for new bits, reallocating as needed
                 this->m_vec.resize(bits2backing_w(new_bit_size));
                 this->set_width_raw(w);
                 this->m_real_size = new_size;
 
-                uint64_t* old_ptr = this->m_vec.data() + old_p.pos;
-                uint64_t* new_ptr = this->m_vec.data() + new_p.pos;
-
                 // move elements into new width grid
-                for (uint64_t i = 0; i < common_size; i++) {
-                    sdsl::bits::move_left((const uint64_t*&) old_ptr, old_p.offset, old_width);
-                    auto v = sdsl::bits::read_int(           old_ptr, old_p.offset, old_width);
-
-                    sdsl::bits::move_left((const uint64_t*&) new_ptr,    new_p.offset, new_width);
-                    sdsl::bits::write_int(                   new_ptr, v, new_p.offset, new_width);
-                }
+                bulk::repack(this->m_vec.data(), common_size, old_width, new_width);
             } else if (old_width > new_width) {
                 // shrink
 
-                uint64_t* old_ptr = this->m_vec.data();
-                uint64_t* new_ptr = this->m_vec.data();
-
-                uint8_t old_offset = 0;
-                uint8_t new_offset = 0;
-
                 // move elements into new width grid
-                for (uint64_t i = 0; i < common_size; i++) {
-                    auto v = sdsl::bits::read_int_and_move((const uint64_t*&) old_ptr, old_offset, old_width);
-                    sdsl::bits::write_int_and_move(new_ptr, v, new_offset, new_width);
-                }
+                bulk::repack(this->m_vec.data(), common_size, old_width, new_width);
 
                 // remove extra bits, dropping as needed
                 this->m_vec.resize(bits2backing_w(new_bit_size));
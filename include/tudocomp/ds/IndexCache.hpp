@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/util/external.hpp>
+
+namespace tdc {
+namespace ds {
+
+/// \brief A persistent cache of text data structure arrays.
+///
+/// Arrays are stored in files in a cache directory. A file's name consists
+/// of a hash of the text and a hash of the data structure's provider,
+/// including its options, so arrays are only reused for the same text and
+/// the same provider. Arrays are read from their files directly into their
+/// storage, without an intermediate copy.
+///
+/// A file consists of a header of \ref HEADER_WORDS 64-bit words, followed
+/// by the provider string and the bit packed array. The header repeats the
+/// text's length and a second hash of it with another seed, and the
+/// provider string is compared in full, so a file is only used if both
+/// 128-bit text hashes and the provider match.
+class IndexCache {
+private:
+    static constexpr uint64_t MAGIC = 0x0032584449434454ULL; // "TDCIDX2"
+    static constexpr size_t HEADER_WORDS = 6;
+
+    static constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+    std::string m_dir;
+    size_t m_text_size;
+    uint64_t m_text_hash;
+    uint64_t m_text_check; // the text's hash with another seed
+
+    inline static uint64_t rotl(uint64_t x, size_t r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline static uint64_t word(const uint8_t* p) {
+        uint64_t x;
+        memcpy(&x, p, 8);
+        return x;
+    }
+
+    inline static uint64_t round(uint64_t acc, uint64_t x) {
+        return rotl(acc + x * P2, 31) * P1;
+    }
+
+    inline static uint64_t merge(uint64_t h, uint64_t acc) {
+        return (h ^ round(0, acc)) * P1 + P4;
+    }
+
+    inline std::string path(const std::string& slot,
+                            const std::string& provider) const {
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx-%016llx.",
+            (unsigned long long) m_text_hash,
+            (unsigned long long) hash(provider));
+        return m_dir + "/" + name + slot;
+    }
+
+    inline static size_t words_for(size_t bytes) {
+        return (bytes + 7) / 8;
+    }
+
+    inline static bool read_fully(int fd, void* buf, size_t bytes) {
+        uint8_t* p = (uint8_t*) buf;
+        while(bytes > 0) {
+            const ssize_t r = read(fd, p, bytes);
+            if(r <= 0) return false;
+            p += r;
+            bytes -= r;
+        }
+        return true;
+    }
+
+    inline bool load(int fd, size_t file_words, const std::string& provider,
+                     DynamicIntVector& iv) const {
+
+        uint64_t header[HEADER_WORDS];
+        if(file_words < HEADER_WORDS || !read_fully(fd, header, sizeof(header))) {
+            return false;
+        }
+
+        const size_t n = header[1];
+        const size_t width = header[2];
+        const size_t words = header[3];
+        const size_t provider_words = words_for(header[5]);
+
+        if(header[0] != MAGIC || n != m_text_size || header[4] != m_text_check ||
+           width == 0 || width > 64 || header[5] != provider.size() ||
+           words != (n * width + 63) / 64 ||
+           file_words != HEADER_WORDS + provider_words + words) {
+            return false;
+        }
+
+        std::vector<uint64_t> p(provider_words);
+        if(!read_fully(fd, p.data(), provider_words * 8) ||
+           memcmp(p.data(), provider.data(), provider.size()) != 0) {
+            return false;
+        }
+
+        DynamicIntVector loaded(n, 0, width);
+        if(!read_fully(fd, loaded.data(), words * 8)) {
+            return false;
+        }
+
+        iv = std::move(loaded);
+        return true;
+    }
+
+public:
+    /// \brief Hashes a sequence of bytes.
+    ///
+    /// This is the 64-bit xxHash, which processes four independent lanes of
+    /// 64-bit words and mixes every input bit into the full hash.
+    inline static uint64_t hash(const uint8_t* data, size_t n, uint64_t seed = 0) {
+        const uint8_t* p = data;
+        const uint8_t* const end = data + n;
+        uint64_t h;
+
+        if(n >= 32) {
+            uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+            for(; p + 32 <= end; p += 32) {
+                v1 = round(v1, word(p));
+                v2 = round(v2, word(p + 8));
+                v3 = round(v3, word(p + 16));
+                v4 = round(v4, word(p + 24));
+            }
+            h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+            h = merge(merge(merge(merge(h, v1), v2), v3), v4);
+        } else {
+            h = seed + P5;
+        }
+        h += n;
+
+        for(; p + 8 <= end; p += 8) {
+            h = rotl(h ^ round(0, word(p)), 27) * P1 + P4;
+        }
+        if(p + 4 <= end) {
+            uint32_t x;
+            memcpy(&x, p, 4);
+            h = rotl(h ^ (uint64_t(x) * P1), 23) * P2 + P3;
+            p += 4;
+        }
+        for(; p < end; p++) {
+            h = rotl(h ^ (uint64_t(*p) * P5), 11) * P1;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        return h ^ (h >> 32);
+    }
+
+    /// \brief Hashes a string.
+    inline static uint64_t hash(const std::string& s, uint64_t seed = 0) {
+        return hash((const uint8_t*) s.data(), s.size(), seed);
+    }
+
+    /// \brief Constructor.
+    /// \param dir The cache directory.
+    /// \param text The text.
+    /// \param n The length of the text.
+    inline IndexCache(const std::string& dir, const uint8_t* text, size_t n)
+        : m_dir(dir), m_text_size(n),
+          m_text_hash(hash(text, n)),
+          m_text_check(hash(text, n, P3)) {
+    }
+
+    /// \brief Loads an array from the cache.
+    ///
+    /// \param slot The data structure's name (e.g., `sa`).
+    /// \param provider A string identifying the data structure's provider.
+    /// \param iv Receives the array.
+    /// \return \c true if the array was found, \c false otherwise.
+    inline bool load(const std::string& slot, const std::string& provider,
+                     DynamicIntVector& iv) const {
+
+        const std::string file = path(slot, provider);
+
+        struct stat st;
+        if(stat(file.c_str(), &st) != 0 || st.st_size % 8 != 0) {
+            return false;
+        }
+
+        const int fd = open(file.c_str(), O_RDONLY);
+        if(fd == -1) {
+            return false;
+        }
+
+        const bool found = load(fd, st.st_size / 8, provider, iv);
+        close(fd);
+        return found;
+    }
+
+    /// \brief Stores an array in the cache.
+    ///
+    /// The file is written under a temporary name and renamed afterwards,
+    /// so concurrent runs never read incomplete files.
+    ///
+    /// \param slot The data structure's name (e.g., `sa`).
+    /// \param provider A string identifying the data structure's provider.
+    /// \param iv The array.
+    inline void store(const std::string& slot, const std::string& provider,
+                      const DynamicIntVector& iv) const {
+
+        const std::string file = path(slot, provider);
+        const std::string tmp = file + ".tmp" + std::to_string(getpid());
+        const size_t words = (iv.bit_size() + 63) / 64;
+
+        {
+            external::Writer<uint64_t> w(tmp, 1ULL << 16);
+            w.push(uint64_t(MAGIC));
+            w.push(iv.size());
+            w.push(iv.width());
+            w.push(words);
+            w.push(m_text_check);
+            w.push(provider.size());
+
+            std::vector<uint64_t> p(words_for(provider.size()), 0);
+            memcpy(p.data(), provider.data(), provider.size());
+            for(auto x : p) w.push(x);
+
+            for(size_t i = 0; i < words; i++) w.push(iv.data()[i]);
+        }
+
+        if(rename(tmp.c_str(), file.c_str()) != 0) {
+            throw std::runtime_error("cannot write cache file " + file);
+        }
+    }
+};
+
+}} //ns
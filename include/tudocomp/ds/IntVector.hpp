@@ -123,6 +123,14 @@ namespace int_vector {
         inline static void bit_reserve(backing_data& self, uint64_t n) {
             width_error();
         }
+        inline static void unpack(const backing_data& self, size_type first, size_type n, uint64_t* out) {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = uint64_t(self[first + i]);
+            }
+        }
+        inline static std::shared_ptr<const Storage> storage(const backing_data& self) {
+            return nullptr;
+        }
     };
 
     template<>
@@ -178,6 +186,12 @@ namespace int_vector {
         inline static void bit_reserve(backing_data& self, uint64_t n) {
             self.bit_reserve(n);
         }
+        inline static void unpack(const backing_data& self, size_type first, size_type n, uint64_t* out) {
+            self.unpack(first, n, out);
+        }
+        inline static std::shared_ptr<const Storage> storage(const backing_data& self) {
+            return self.storage();
+        }
     };
 
     template<size_t N>
@@ -234,6 +248,12 @@ namespace int_vector {
         inline static void bit_reserve(backing_data& self, uint64_t n) {
             width_error();
         }
+        inline static void unpack(const backing_data& self, size_type first, size_type n, uint64_t* out) {
+            self.unpack(first, n, out);
+        }
+        inline static std::shared_ptr<const Storage> storage(const backing_data& self) {
+            return self.storage();
+        }
     };
 
     /// A vector over arbitrary unsigned integer types.
@@ -451,6 +471,29 @@ namespace int_vector {
             m_data.shrink_to_fit();
         }
 
+        /// Decodes the elements [first, first + n) into out.
+        ///
+        /// For bit packed storage, elements are decoded a block of
+        /// bulk::BLOCK at a time, which is much faster than accessing them
+        /// one by one.
+        inline void unpack(size_type first, size_type n, uint64_t* out) const {
+            IntVectorTrait<T>::unpack(m_data, first, n, out);
+        }
+
+        /// Calls `f(value)` for all elements in order, decoding a block of
+        /// bulk::BLOCK elements at a time.
+        template<class F>
+        inline void for_each(F f) const {
+            uint64_t buf[bulk::BLOCK];
+            for (size_t i = 0; i < size(); i += bulk::BLOCK) {
+                const size_t n = std::min(bulk::BLOCK, size() - i);
+                unpack(i, n, buf);
+                for (size_t j = 0; j < n; j++) {
+                    f(buf[j]);
+                }
+            }
+        }
+
         template<class Idx>
         inline reference operator[](const Idx& n) {
             return m_data[conversion_helper<Idx, value_type, size_type>(n)];
@@ -495,6 +538,14 @@ namespace int_vector {
             return m_data.data();
         }
 
+        /// Yields the \ref Storage of the elements, \c nullptr for the heap.
+        ///
+        /// Only bit packed vectors are allocated according to the current
+        /// storage when they are created, see \ref StorageScope.
+        inline std::shared_ptr<const Storage> storage() const {
+            return IntVectorTrait<T>::storage(m_data);
+        }
+
         template <class InputIterator>
         inline void assign(InputIterator first, InputIterator last) {
             m_data.assign(first, last);
@@ -583,6 +634,47 @@ namespace int_vector {
         friend void swap(IntVector<U>& lhs, IntVector<U>& rhs);
     };
 
+    /// Reads an IntVector front to back, decoding a block of bulk::BLOCK
+    /// elements at a time.
+    ///
+    /// This is meant for sequential scans that can not be written as a
+    /// IntVector::for_each, for instance when scanning several vectors at
+    /// once.
+    template<class T>
+    class ChunkedReader {
+        const IntVector<T>* m_iv;
+        size_t m_block; // the position of the buffered block
+        size_t m_pos;   // the position in the buffer
+        uint64_t m_buf[bulk::BLOCK];
+
+        inline void fill() {
+            const size_t n = std::min(bulk::BLOCK, m_iv->size() - m_block);
+            m_iv->unpack(m_block, n, m_buf);
+        }
+    public:
+        /// Starts reading at position first.
+        inline ChunkedReader(const IntVector<T>& iv, size_t first = 0):
+            m_iv(&iv),
+            m_block(first - first % bulk::BLOCK),
+            m_pos(first % bulk::BLOCK)
+        {
+            if (m_block < iv.size()) fill();
+        }
+
+        ChunkedReader(const ChunkedReader& other) = delete;
+
+        /// Yields the current element and advances to the next one.
+        inline uint64_t next() {
+            DCHECK_LT(m_block + m_pos, m_iv->size());
+            if (m_pos == bulk::BLOCK) {
+                m_block += bulk::BLOCK;
+                m_pos = 0;
+                fill();
+            }
+            return m_buf[m_pos++];
+        }
+    };
+
     template<class T>
     bool operator==(const IntVector<T>& lhs, const IntVector<T>& rhs) {
         return lhs.m_data == rhs.m_data;
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <tudocomp/io/MMapHandle.hpp>
+
+namespace tdc {
+namespace int_vector {
+
+/// \brief Describes where the storage of bit packed integer vectors is
+///        allocated.
+///
+/// By default, storage is allocated on the heap. Large vectors can instead
+/// be stored in anonymous memory maps backed by transparent huge pages,
+/// which saves TLB misses on random accesses, or in memory maps of scratch
+/// files, which lets the operating system page them out when they exceed
+/// the available memory.
+///
+/// Vectors take the storage that is current in their thread when they are
+/// created, see \ref StorageScope, and keep it when they grow or are
+/// copied. New threads start with the heap as their current storage.
+struct Storage {
+    enum class Kind {
+        heap,
+        huge_pages,
+        file
+    };
+
+    /// \brief Storage of fewer bytes is always allocated on the heap.
+    static constexpr size_t MIN_MAPPED = size_t(1) << 20;
+
+    Kind kind = Kind::heap;
+
+    /// \brief The directory of scratch files.
+    std::string dir;
+
+    /// \brief Parses a storage description.
+    ///
+    /// \param kind `heap`, `hugepages` or `file`.
+    /// \param dir The directory of scratch files for `file`.
+    inline static std::shared_ptr<const Storage> parse(
+        const std::string& kind, const std::string& dir) {
+
+        if(kind == "heap") {
+            return nullptr;
+        } else if(kind == "hugepages") {
+            return std::make_shared<const Storage>(Storage { Kind::huge_pages, "" });
+        } else if(kind == "file") {
+            return std::make_shared<const Storage>(Storage { Kind::file, dir });
+        } else {
+            throw std::invalid_argument("unknown storage: " + kind);
+        }
+    }
+
+    /// \brief The storage of vectors newly created by the calling thread,
+    ///        \c nullptr for the heap.
+    inline static std::shared_ptr<const Storage>& current() {
+        static thread_local std::shared_ptr<const Storage> s;
+        return s;
+    }
+};
+
+/// \brief Sets the current \ref Storage of the calling thread during its
+///        lifetime.
+class StorageScope {
+    std::shared_ptr<const Storage> m_prev;
+
+public:
+    inline StorageScope(std::shared_ptr<const Storage> storage)
+        : m_prev(std::move(Storage::current())) {
+        Storage::current() = std::move(storage);
+    }
+
+    inline ~StorageScope() {
+        Storage::current() = std::move(m_prev);
+    }
+
+    StorageScope(const StorageScope&) = delete;
+    StorageScope& operator=(const StorageScope&) = delete;
+};
+
+/// \cond INTERNAL
+class MappedStorage {
+    std::mutex m_mutex;
+    std::unordered_map<const void*, io::MMap> m_maps;
+
+public:
+    inline static MappedStorage& instance() {
+        static MappedStorage s;
+        return s;
+    }
+
+    inline void* allocate(const Storage& storage, size_t bytes) {
+        io::MMap m = (storage.kind == Storage::Kind::file)
+            ? io::MMap::scratch(storage.dir, bytes)
+            : io::MMap::huge_pages(bytes);
+
+        void* p = m.view().data();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maps.emplace(p, std::move(m));
+        return p;
+    }
+
+    // unmaps the storage, or yields false if it was not mapped
+    inline bool deallocate(const void* p) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_maps.erase(p) > 0;
+    }
+};
+/// \endcond
+
+/// \brief Allocates the storage of vectors according to a \ref Storage.
+///
+/// Any instance can free storage allocated by any other.
+template<typename T>
+class StorageAllocator {
+    template<typename U> friend class StorageAllocator;
+
+    std::shared_ptr<const Storage> m_storage;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::true_type;
+
+    inline StorageAllocator(): m_storage(Storage::current()) {}
+
+    template<typename U>
+    inline StorageAllocator(const StorageAllocator<U>& other)
+        : m_storage(other.m_storage) {}
+
+    inline T* allocate(size_t n) {
+        if(m_storage && n * sizeof(T) >= Storage::MIN_MAPPED) {
+            return (T*) MappedStorage::instance().allocate(*m_storage, n * sizeof(T));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    inline void deallocate(T* p, size_t n) {
+        if(n * sizeof(T) < Storage::MIN_MAPPED ||
+           !MappedStorage::instance().deallocate(p)) {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    /// \brief Yields the storage of allocations, \c nullptr for the heap.
+    inline const std::shared_ptr<const Storage>& storage() const {
+        return m_storage;
+    }
+
+    template<typename U>
+    inline bool operator==(const StorageAllocator<U>&) const { return true; }
+    template<typename U>
+    inline bool operator!=(const StorageAllocator<U>&) const { return false; }
+};
+
+}} //ns
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/ds/WaveletMatrix.hpp>
+#include <tudocomp/ds/bwt.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the LCP array from the BWT.
+///
+/// Following Beller et al., "Computing the longest common prefix array
+/// based on the Burrows-Wheeler transform" (JDA 2013), the intervals of all
+/// substrings of length l are enumerated level by level using backward
+/// search on a wavelet matrix of the BWT. The right border of each newly
+/// found interval is an LCP entry of value l.
+///
+/// Neither the Phi nor the PLCP array is needed. Besides the suffix array
+/// and the LCP array, about n log(sigma) bits are used for the wavelet
+/// matrix, n bits to mark the computed entries and the queue of intervals,
+/// which is turned into two bit vectors if it grows large. This makes it
+/// the provider of choice for low memory budgets.
+class LCPFromBWT: public Algorithm, public ArrayDS {
+private:
+    len_t m_max;
+
+    struct interval_t {
+        len_t begin, end;
+    };
+
+    // The intervals of a level. Intervals of the same level are disjoint,
+    // so many of them are stored as bit vectors marking their first and
+    // last positions.
+    class queue_t {
+    private:
+        size_t m_n;
+        size_t m_limit;
+        std::vector<interval_t> m_list;
+        std::vector<uint64_t> m_first, m_last;
+        bool m_bits = false;
+
+        static inline void set(std::vector<uint64_t>& bv, size_t i) {
+            bv[i / 64] |= 1ULL << (i % 64);
+        }
+
+    public:
+        inline queue_t(size_t n) : m_n(n), m_limit(n / 64) {}
+
+        inline void push(len_t begin, len_t end) {
+            if(!m_bits && m_list.size() >= m_limit && m_limit > 0) {
+                m_first.assign(m_n / 64 + 1, 0);
+                m_last.assign(m_n / 64 + 1, 0);
+                for(auto& x : m_list) {
+                    set(m_first, x.begin);
+                    set(m_last, x.end - 1);
+                }
+                std::vector<interval_t>().swap(m_list);
+                m_bits = true;
+            }
+
+            if(m_bits) {
+                set(m_first, begin);
+                set(m_last, end - 1);
+            } else {
+                m_list.push_back(interval_t { begin, end });
+            }
+        }
+
+        inline bool empty() const {
+            return !m_bits && m_list.empty();
+        }
+
+        /// Calls f(begin, end) for all intervals and clears the queue.
+        template<typename F>
+        inline void pop_all(F f) {
+            if(m_bits) {
+                // the interval of each first position ends at the next
+                // last position
+                size_t last_word = 0;
+                uint64_t last_bits = m_last[0];
+                for(size_t w = 0; w < m_first.size(); w++) {
+                    for(uint64_t x = m_first[w]; x; x &= x - 1) {
+                        const size_t begin = w * 64 + __builtin_ctzll(x);
+
+                        // drop last positions before begin
+                        if(last_word < w) {
+                            last_word = w;
+                            last_bits = m_last[w];
+                        }
+                        if(last_word == w) {
+                            last_bits &= ~((1ULL << (begin % 64)) - 1);
+                        }
+                        while(!last_bits) last_bits = m_last[++last_word];
+
+                        const size_t last = last_word * 64 + __builtin_ctzll(last_bits);
+                        f(len_t(begin), len_t(last + 1));
+                    }
+                }
+                std::vector<uint64_t>().swap(m_first);
+                std::vector<uint64_t>().swap(m_last);
+                m_bits = false;
+            } else {
+                std::vector<interval_t> list;
+                std::swap(list, m_list);
+                for(auto& x : list) f(x.begin, x.end);
+            }
+        }
+    };
+
+public:
+    inline static Meta meta() {
+        Meta m("lcp", "from_bwt", "Interval enumeration on the BWT");
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    inline static ds::dsflags_t dependencies() {
+        return ds::SA;
+    }
+
+    inline LCPFromBWT(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)),
+          m_max(max_value()) {
+    }
+
+    template<typename textds_t>
+    inline LCPFromBWT(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        // Construct Suffix Array
+        auto& sa = t.require_sa(cm);
+
+        const size_t n = t.size();
+
+        StatPhase::wrap("Construct LCP Array", [&]{
+            // Construct the wavelet matrix of the BWT and the C array
+            WaveletMatrix wm;
+            std::vector<len_t> C(ULITERAL_MAX + 2, 0);
+            StatPhase::wrap("Construct Wavelet Matrix", [&]{
+                std::vector<uliteral_t> bwt(n);
+                for(size_t i = 0; i < n; i++) {
+                    bwt[i] = bwt::bwt(t, sa, i);
+                    ++C[size_t(bwt[i]) + 1];
+                }
+                for(size_t c = 1; c < C.size(); c++) C[c] += C[c - 1];
+
+                wm = WaveletMatrix(bwt);
+            });
+
+            // The maximum LCP value is not known in advance
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? bits_for(n) : LEN_BITS));
+
+            StatPhase::wrap("Enumerate Intervals", [&]{
+                iv_t& lcp = *this;
+                std::vector<uint64_t> done(n / 64 + 1, 0);
+                auto is_done = [&](size_t i) {
+                    return (done[i / 64] >> (i % 64)) & 1ULL;
+                };
+
+                queue_t queue(n), next(n);
+                queue.push(0, n);
+                len_t last_begin = 0;
+                if(n > 0) done[0] |= 1;
+
+                m_max = 0;
+                size_t l = 0;
+                for(; !queue.empty(); ++l) {
+                    queue.pop_all([&](len_t b, len_t e) {
+                        wm.for_each_symbol(b, e, [&](uliteral_t c, len_t rb, len_t re) {
+                            const len_t b2 = C[c] + rb;
+                            const len_t e2 = C[c] + re;
+                            if(e2 == n) {
+                                // there is no LCP entry at the end, the
+                                // interval is new if it shrank
+                                if(b2 != last_begin) {
+                                    last_begin = b2;
+                                    next.push(b2, e2);
+                                }
+                            } else if(!is_done(e2)) {
+                                done[e2 / 64] |= 1ULL << (e2 % 64);
+                                lcp[e2] = l;
+                                m_max = l;
+                                next.push(b2, e2);
+                            }
+                        });
+                    });
+                    std::swap(queue, next);
+                }
+
+                DCHECK([&]{
+                    for(size_t i = 0; i < n; i++) if(!is_done(i)) return false;
+                    return true;
+                }());
+
+                StatPhase::log("levels", l);
+            });
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::delayed) compress();
+    }
+
+	inline len_t max_lcp() const {
+		return m_max;
+	}
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress LCP Array", [this]{
+            width(bits_for(m_max));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
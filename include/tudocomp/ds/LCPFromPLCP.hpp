@@ -23,6 +23,15 @@ public:
         return ds::InputRestrictions {};
     }
 
+    inline static ds::dsflags_t dependencies() {
+        return ds::SA | ds::PLCP;
+    }
+
+    inline LCPFromPLCP(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)),
+          m_max(max_value()) {
+    }
+
     template<typename textds_t>
     inline LCPFromPLCP(Env&& env, textds_t& t, CompressMode cm)
             : Algorithm(std::move(env)) {
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the LCP array from the PLCP array with multiple threads.
+///
+/// Each thread fills a word aligned range of the LCP array by looking up
+/// the PLCP values of the corresponding suffixes.
+///
+/// The option `threads` sets the amount of threads to use, where zero
+/// selects the amount of hardware threads.
+class LCPParallel: public Algorithm, public ArrayDS {
+private:
+    len_t m_max;
+
+public:
+    inline static Meta meta() {
+        Meta m("lcp", "parallel", "Parallel lookup in the PLCP array");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    inline static ds::dsflags_t dependencies() {
+        return ds::SA | ds::PLCP;
+    }
+
+    inline LCPParallel(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)),
+          m_max(max_value()) {
+    }
+
+    template<typename textds_t>
+    inline LCPParallel(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        // Construct Suffix Array and PLCP Array
+        auto& sa = t.require_sa(cm);
+        auto& plcp = t.require_plcp(cm);
+
+        const size_t n = t.size();
+
+        StatPhase::wrap("Construct LCP Array", [&]{
+            // Compute LCP array
+            m_max = plcp.max_lcp();
+            const size_t w = bits_for(m_max);
+
+            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
+
+            iv_t& lcp = *this;
+            parallel::for_chunks(n, threads, 64, [&](size_t, size_t b, size_t e) {
+                for(size_t i = std::max(b, size_t(1)); i < e; i++) {
+                    lcp[i] = plcp[sa[i]];
+                }
+            });
+            if(n > 0) lcp[0] = 0;
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::delayed) compress();
+    }
+
+	inline len_t max_lcp() const {
+		return m_max;
+	}
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress LCP Array", [this]{
+            width(bits_for(m_max));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
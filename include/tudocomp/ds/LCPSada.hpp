@@ -3,7 +3,8 @@
 #include <tudocomp/util.hpp>
 #include <tudocomp/Env.hpp>
 #include <tudocomp/ds/IntVector.hpp>
-#include <sdsl/select_support_mcl.hpp> // for the select data structure
+#include <tudocomp/ds/RankSelectBitVector.hpp> // for the select data structure
+#include <sdsl/int_vector.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
 
@@ -60,28 +61,24 @@ inline void phi_algorithm(phi_t& phi, const text_t& text) {
 
 
 
-template<
-typename sa_t,
-typename select_t = sdsl::select_support_mcl<1,1>>
+template<typename sa_t>
 class LCPSada {
 	const sa_t& m_sa;
-	const sdsl::bit_vector m_bv;
-	const select_t m_select;
+	const RankSelectBitVector m_bv;
 	public:
 	LCPSada(const sa_t& sa, const sdsl::bit_vector&& bv)
 		: m_sa(sa)
-		, m_bv(bv)
-		, m_select(&m_bv)
+		, m_bv(bv.data(), bv.size())
 	{
 	}
 	len_t operator[](len_t i) const {
 		if(size() == 1) return 0;
 		const len_t idx = m_sa[i];
-		return m_select.select(idx+1) - 2*idx;
+		return m_bv.select1(idx+1) - 2*idx;
 	}
 	len_t plcp(len_t idx) const {
 		if(size() == 1) return 0;
-		return m_select.select(idx+1) - 2*idx;
+		return m_bv.select1(idx+1) - 2*idx;
 	}
     inline len_t size() const {
 		return m_sa.size();
@@ -170,7 +167,7 @@ inline static sdsl::bit_vector construct_plcp_bitvector(const plcp_t& plcp) {
 	return bv;
 }
 
-template<class sa_t, class text_t, class select_t = sdsl::select_support_mcl<1,1>>
+template<class sa_t, class text_t>
 sdsl::bit_vector construct_plcp_bitvector(Env& env, const sa_t& sa, const text_t& text) {
 	typedef DynamicIntVector phi_t;
 
@@ -189,11 +186,11 @@ sdsl::bit_vector construct_plcp_bitvector(Env& env, const sa_t& sa, const text_t
     });
 }
 
-template<class sa_t, class text_t, class select_t = sdsl::select_support_mcl<1,1>>
-LCPSada<sa_t,select_t> construct_lcp_sada(Env& env, const sa_t& sa, const text_t& text) {
+template<class sa_t, class text_t>
+LCPSada<sa_t> construct_lcp_sada(Env& env, const sa_t& sa, const text_t& text) {
     return StatPhase::wrap("Build Select on Bit Vector", [&]{
         sdsl::bit_vector bv = construct_plcp_bitvector(env, sa, text);
-        return LCPSada<sa_t,select_t> { sa, std::move(bv) };
+        return LCPSada<sa_t> { sa, std::move(bv) };
     });
 }
 
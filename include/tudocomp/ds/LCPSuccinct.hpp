@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/LCPSada.hpp>
+#include <tudocomp/ds/RankSelectBitVector.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Provides the LCP array in about 2n bits.
+///
+/// Following Sadakane, "Succinct representations of lcp information and
+/// improvements in the compressed suffix arrays" (SODA 2002), the PLCP
+/// array is stored as a bit vector with a set bit at position
+/// PLCP[i] + 2i for each text position i. Then LCP[i] = select(SA[i] + 1)
+/// - 2 SA[i], where select(k) is the position of the k-th set bit.
+///
+/// The bit vector is built by \ref construct_plcp_bitvector, and select is
+/// answered in near constant time by a \ref RankSelectBitVector as in
+/// \ref LCPSada, which takes another 2n/7 bits.
+///
+/// Accesses need the suffix array, which therefore must stay available in
+/// the text data structures as long as this data structure is in use.
+/// Consumers that need to modify the LCP array get a bit packed copy using
+/// \ref relinquish or \ref copy.
+class LCPSuccinct: public Algorithm {
+public:
+    /// \brief The data structure's data type.
+    using data_type = DynamicIntVector;
+
+private:
+    size_t m_size = 0;
+    len_t m_max = 0;
+
+    RankSelectBitVector m_bv;
+
+    // type erased access to the suffix array
+    const void* m_sa = nullptr;
+    len_t (*m_sa_access)(const void*, size_t) = nullptr;
+
+    inline len_t plcp(size_t i) const {
+        return len_t(m_bv.select1(i + 1) - 2 * i);
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("lcp", "sada", "Succinct LCP array by Sadakane");
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    inline static ds::dsflags_t dependencies() {
+        return ds::SA | ds::PLCP;
+    }
+
+    inline static ds::dsflags_t retained_dependencies() {
+        return ds::SA;
+    }
+
+    template<typename textds_t>
+    inline LCPSuccinct(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        using sa_t = typename textds_t::sa_type;
+
+        // Construct Suffix Array and PLCP Array
+        auto& sa = t.require_sa(cm);
+        auto& plcp = t.require_plcp(cm);
+
+        m_sa = &sa;
+        m_sa_access = [](const void* sa, size_t i) {
+            return len_t((*(const sa_t*) sa)[i]);
+        };
+
+        const size_t n = t.size();
+        m_size = n;
+
+        StatPhase::wrap("Construct LCP Array", [&]{
+            m_max = plcp.max_lcp();
+
+            {
+                sdsl::bit_vector bv = construct_plcp_bitvector(plcp);
+                m_bv = RankSelectBitVector(bv.data(), bv.size());
+            }
+            DCHECK_EQ(m_bv.ones(), n);
+
+            StatPhase::log("bit_vector_length", m_bv.size());
+            StatPhase::log("size", m_bv.size_in_bytes());
+        });
+    }
+
+    inline LCPSuccinct(LCPSuccinct&& other) = default;
+    inline LCPSuccinct& operator=(LCPSuccinct&& other) = default;
+
+    /// \brief Accesses the LCP array at position i.
+    inline len_t operator[](size_t i) const {
+        return plcp(m_sa_access(m_sa, i));
+    }
+
+    /// \brief Yields the size of the LCP array.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    inline len_t max_lcp() const {
+        return m_max;
+    }
+
+    /// \brief Does nothing, the data structure is already compressed.
+    inline void compress() {
+    }
+
+    /// \brief Creates a bit packed copy of the LCP array.
+    inline data_type copy() const {
+        using namespace int_vector;
+
+        data_type iv(m_size, 0, bits_for(m_max));
+        uint64_t buf[bulk::BLOCK];
+        for(size_t i = 0; i < m_size; i += bulk::BLOCK) {
+            const size_t n = std::min(bulk::BLOCK, m_size - i);
+            for(size_t j = 0; j < n; j++) buf[j] = (*this)[i + j];
+            bulk::pack(buf, iv.width(), iv.data() + (i / bulk::BLOCK) * iv.width(), n);
+        }
+        return iv;
+    }
+
+    /// \brief Creates a bit packed copy of the LCP array and releases the
+    ///        bit vector.
+    inline data_type relinquish() {
+        data_type iv = copy();
+        m_bv = RankSelectBitVector();
+        return iv;
+    }
+};
+
+} //ns
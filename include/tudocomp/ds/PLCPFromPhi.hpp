@@ -23,6 +23,15 @@ public:
         return ds::InputRestrictions {};
     }
 
+    inline static ds::dsflags_t inplace_dependencies() {
+        return ds::PHI;
+    }
+
+    inline PLCPFromPhi(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)),
+          m_max(max_value()) {
+    }
+
     template<typename textds_t>
     inline PLCPFromPhi(Env&& env, textds_t& t, CompressMode cm)
             : Algorithm(std::move(env)) {
@@ -42,6 +51,7 @@ public:
                 (*this)[i] = l;
                 if(l) --l;
             }
+            (*this)[n-1] = 0; // the sentinel shares no prefix
 
             StatPhase::log("bit_width", size_t(width()));
             StatPhase::log("size", bit_size() / 8);
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the PLCP array using the phi array with multiple threads.
+///
+/// The text positions are split into segments, one per thread, in which
+/// the Phi algorithm runs independently. At a segment's start, the PLCP
+/// value is computed by direct character comparison, like an irreducible
+/// value, and the remainder of the segment reuses it as usual. The array
+/// is computed in-place of the Phi array.
+///
+/// The option `threads` sets the amount of threads to use, where zero
+/// selects the amount of hardware threads.
+class PLCPParallel: public Algorithm, public ArrayDS {
+private:
+    len_t m_max;
+
+public:
+    inline static Meta meta() {
+        Meta m("plcp", "parallel", "Parallel Phi algorithm");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {};
+    }
+
+    inline static ds::dsflags_t inplace_dependencies() {
+        return ds::PHI;
+    }
+
+    inline PLCPParallel(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)),
+          m_max(max_value()) {
+    }
+
+    template<typename textds_t>
+    inline PLCPParallel(Env&& env, textds_t& t, CompressMode cm)
+            : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        const size_t n = t.size();
+
+        // Construct Phi and attempt to work in-place
+        set_array(t.inplace_phi(cm));
+
+        StatPhase::wrap("Construct PLCP Array", [&]{
+            iv_t& plcp = *this;
+            std::vector<len_t> max(threads, 0);
+
+            // segments are word aligned, so threads never share a word of
+            // the bit packed array
+            parallel::for_chunks(n - 1, threads, 64,
+                [&](size_t tid, size_t b, size_t e) {
+                    len_t seg_max = 0;
+                    for(len_t i = b, l = 0; i < e; ++i) {
+                        const len_t phii = plcp[i];
+                        while(t[i+l] == t[phii+l]) ++l;
+                        seg_max = std::max(seg_max, l);
+                        plcp[i] = l;
+                        if(l) --l;
+                    }
+                    max[tid] = seg_max;
+                });
+
+            plcp[n-1] = 0; // the sentinel shares no prefix
+            m_max = *std::max_element(max.begin(), max.end());
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            compress();
+        }
+    }
+
+	inline len_t max_lcp() const {
+		return m_max;
+	}
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress PLCP Array", [this]{
+            width(bits_for(m_max));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
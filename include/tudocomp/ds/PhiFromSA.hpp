@@ -3,16 +3,23 @@
 #include <tudocomp/ds/TextDSFlags.hpp>
 #include <tudocomp/ds/CompressMode.hpp>
 #include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
 
 #include <tudocomp_stat/StatPhase.hpp>
 
 namespace tdc {
 
 /// Constructs the Phi array using the suffix array.
+///
+/// Unless the compression mode is `compressed`, the suffix array is
+/// scattered in buckets (see \ref parallel::scatter). The option `threads`
+/// sets the amount of threads to use, where zero selects the amount of
+/// hardware threads. It defaults to one, like the other default providers.
 class PhiFromSA: public Algorithm, public ArrayDS {
 public:
     inline static Meta meta() {
         Meta m("phi", "from_sa");
+        m.option("threads").dynamic(1);
         return m;
     }
 
@@ -20,10 +27,21 @@ public:
         return ds::InputRestrictions {};
     }
 
+    inline static ds::dsflags_t dependencies() {
+        return ds::SA;
+    }
+
+    inline PhiFromSA(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)) {
+    }
+
     template<typename textds_t>
     inline PhiFromSA(Env&& env, textds_t& t, CompressMode cm)
             : Algorithm(std::move(env)) {
 
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
         // Construct Suffix Array
         auto& sa = t.require_sa(cm);
 
@@ -34,11 +52,21 @@ public:
             // Construct Phi Array
             set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w : LEN_BITS));
 
-            for(len_t i = 1, prev = sa[0]; i < n; i++) {
-                (*this)[sa[i]] = prev;
-                prev = sa[i];
+            iv_t& phi = *this;
+            if(cm == CompressMode::compressed) {
+                for(len_t i = 1, prev = sa[0]; i < n; i++) {
+                    phi[sa[i]] = prev;
+                    prev = sa[i];
+                }
+                phi[sa[0]] = sa[n-1];
+            } else {
+                parallel::scatter(phi, n,
+                    [&](size_t i) { return len_t(sa[i]); },
+                    [&](size_t i) { return len_t(sa[(i > 0) ? i - 1 : n - 1]); },
+                    threads);
             }
-            (*this)[sa[0]] = sa[n-1];
+
+            StatPhase::log("threads", threads);
 
             StatPhase::log("bit_width", size_t(width()));
             StatPhase::log("size", bit_size() / 8);
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include <tudocomp/def.hpp>
+
+#include <glog/logging.h>
+
+namespace tdc {
+
+/// \brief A bit vector with support for rank and select queries.
+///
+/// Following Vigna, "Broadword Implementation of Rank/Select Queries"
+/// (WEA 2008), the bits are stored in blocks of 512 bits. Each block is
+/// preceded by the amount of set bits before it and the amounts within the
+/// block before each of its words in 9 bits each. Since this metadata is
+/// interleaved with the bits, a rank query reads 80 consecutive bytes and
+/// counts the bits of a single word. This takes n/4 bits in addition to the
+/// vector.
+///
+/// Select queries start from the block of every 512th set bit and find the
+/// block of the requested set bit using the lowest 16 bits of the rank of
+/// each block, which are stored separately so that the scanned blocks are
+/// not touched. This takes another n/32 bits, plus a position per 512 set
+/// bits for the samples. With `BMI2`, the bit is finally located within its
+/// word using `pdep`.
+///
+/// Bits are written with \ref set, after which \ref build must be called
+/// before any rank or select queries.
+class RankSelectBitVector {
+public:
+    /// \brief The number of bits of the vector stored in a block.
+    static constexpr size_t BLOCK_BITS = 512;
+
+    /// \brief Every this many set bits, the block is sampled for select.
+    static constexpr size_t SAMPLE_RATE = 512;
+
+private:
+    // the words of a block, the two words of metadata followed by the bits
+    static constexpr size_t BLOCK_WORDS = 2 + BLOCK_BITS / 64;
+
+    size_t m_size = 0;
+    size_t m_ones = 0;
+    size_t m_num_blocks = 0;
+
+    std::vector<uint64_t> m_blocks;
+
+    // the block containing every SAMPLE_RATE-th set bit
+    std::vector<len_t> m_samples;
+
+    // the lowest 16 bits of the rank of each block
+    std::vector<uint16_t> m_low_ranks;
+
+    inline uint64_t& word(size_t i) {
+        return m_blocks[(i / BLOCK_BITS) * BLOCK_WORDS + 2 + (i / 64) % 8];
+    }
+
+    inline uint64_t word(size_t i) const {
+        return m_blocks[(i / BLOCK_BITS) * BLOCK_WORDS + 2 + (i / 64) % 8];
+    }
+
+    // yields the amount of set bits in a block before its word w
+    inline static size_t relative_rank(const uint64_t* block, size_t w) {
+        return (w > 0) ? (block[1] >> (9 * (w - 1))) & 0x1FFULL : 0;
+    }
+
+    // yields the position of the k-th set bit in x, starting with k = 0
+    inline static size_t select64(uint64_t x, size_t k) {
+#ifdef __BMI2__
+        return __builtin_ctzll(_pdep_u64(1ULL << k, x));
+#else
+        size_t pos = 0;
+        for(size_t c; (c = __builtin_popcountll(x & 0xFFULL)) <= k; x >>= 8) {
+            k -= c;
+            pos += 8;
+        }
+        for(; k > 0; --k) x &= x - 1;
+        return pos + __builtin_ctzll(x);
+#endif
+    }
+
+public:
+    /// \brief Constructs an empty bit vector.
+    inline RankSelectBitVector() {
+        resize(0);
+    }
+
+    /// \brief Constructs a bit vector of \c n unset bits.
+    inline explicit RankSelectBitVector(size_t n) {
+        resize(n);
+    }
+
+    /// \brief Constructs a bit vector from \c n bits packed into words,
+    ///        as by \ref BitVector or `sdsl::bit_vector`, and builds the
+    ///        rank and select support.
+    inline RankSelectBitVector(const uint64_t* words, size_t n) {
+        resize(n);
+        for(size_t w = 0; w < (n + 63) / 64; w++) {
+            word(w * 64) = words[w];
+        }
+        if(n % 64 != 0) word(n - 1) &= (1ULL << (n % 64)) - 1;
+        build();
+    }
+
+    /// \brief Resizes the vector to \c n unset bits.
+    inline void resize(size_t n) {
+        m_size = n;
+        m_ones = 0;
+
+        // the last block holds the total amount of set bits
+        m_num_blocks = n / BLOCK_BITS + 1;
+        m_blocks.assign(m_num_blocks * BLOCK_WORDS, 0);
+        m_blocks.shrink_to_fit();
+        m_samples.clear();
+        m_low_ranks.clear();
+    }
+
+    /// \brief Yields the number of bits.
+    inline size_t size() const {
+        return m_size;
+    }
+
+    /// \brief Yields the number of set bits, as of the last \ref build.
+    inline size_t ones() const {
+        return m_ones;
+    }
+
+    /// \brief Yields the bit at position \c i.
+    inline bool operator[](size_t i) const {
+        DCHECK_LT(i, m_size);
+        return (word(i) >> (i % 64)) & 1ULL;
+    }
+
+    /// \brief Sets the bit at position \c i to \c v.
+    inline void set(size_t i, bool v = true) {
+        DCHECK_LT(i, m_size);
+        const uint64_t mask = 1ULL << (i % 64);
+        if(v) word(i) |= mask;
+        else  word(i) &= ~mask;
+    }
+
+    /// \brief Computes the rank and select support for the current bits.
+    inline void build() {
+        m_samples.clear();
+        m_low_ranks.resize(m_num_blocks);
+        m_low_ranks.shrink_to_fit();
+
+        size_t ones = 0;
+        for(size_t b = 0; b < m_num_blocks; b++) {
+            uint64_t* block = m_blocks.data() + b * BLOCK_WORDS;
+            block[0] = ones;
+            block[1] = 0;
+            m_low_ranks[b] = uint16_t(ones);
+
+            size_t c = 0;
+            for(size_t w = 0; w < BLOCK_BITS / 64; w++) {
+                if(w > 0) block[1] |= uint64_t(c) << (9 * (w - 1));
+                c += __builtin_popcountll(block[2 + w]);
+            }
+
+            // the block contains the set bits [ones, ones + c)
+            for(size_t k = (ones + SAMPLE_RATE - 1) / SAMPLE_RATE * SAMPLE_RATE;
+                k < ones + c; k += SAMPLE_RATE) {
+                m_samples.push_back(b);
+            }
+            ones += c;
+        }
+        m_ones = ones;
+    }
+
+    /// \brief Yields the number of set bits in the range `[0, i)`.
+    inline size_t rank1(size_t i) const {
+        DCHECK_LE(i, m_size);
+        const uint64_t* block = m_blocks.data() + (i / BLOCK_BITS) * BLOCK_WORDS;
+        const size_t w = (i / 64) % 8;
+
+        size_t rank = block[0] + relative_rank(block, w);
+        if(i % 64 != 0) {
+            rank += __builtin_popcountll(block[2 + w] & ((1ULL << (i % 64)) - 1));
+        }
+        return rank;
+    }
+
+    /// \brief Yields the number of unset bits in the range `[0, i)`.
+    inline size_t rank0(size_t i) const {
+        return i - rank1(i);
+    }
+
+    /// \brief Yields the position of the k-th set bit, starting with
+    ///        `k = 1`.
+    inline size_t select1(size_t k) const {
+        DCHECK_GE(k, 1U);
+        DCHECK_LE(k, m_ones);
+        --k;
+
+        // find the last block with at most k set bits before it
+        const size_t s = k / SAMPLE_RATE;
+        size_t lo = m_samples[s];
+        size_t hi = (s + 1 < m_samples.size()) ? m_samples[s + 1] + 1 : m_num_blocks;
+
+        // the ranks of the blocks in [lo, hi) differ from k by less than
+        // SAMPLE_RATE + BLOCK_BITS, so their lowest 16 bits suffice
+        const uint16_t k16 = uint16_t(k);
+        auto at_most_k = [&](size_t b) {
+            return int16_t(uint16_t(k16 - m_low_ranks[b])) >= 0;
+        };
+        if(hi - lo <= 8) {
+            // dense blocks, as usual
+            while(lo + 1 < hi && at_most_k(lo + 1)) ++lo;
+        } else {
+            while(hi - lo > 1) {
+                const size_t mid = (lo + hi) / 2;
+                if(at_most_k(mid)) lo = mid;
+                else hi = mid;
+            }
+        }
+
+        // find the word, the relative ranks are increasing
+        const uint64_t* block = m_blocks.data() + lo * BLOCK_WORDS;
+        DCHECK_LE(block[0], k);
+        k -= block[0];
+        size_t w = 0;
+        for(size_t j = 1; j < BLOCK_BITS / 64; j++) {
+            w += (relative_rank(block, j) <= k);
+        }
+        k -= relative_rank(block, w);
+
+        return lo * BLOCK_BITS + w * 64 + select64(block[2 + w], k);
+    }
+
+    /// \brief Yields the size of the data structure in bytes.
+    inline size_t size_in_bytes() const {
+        return m_blocks.size() * sizeof(uint64_t) +
+            m_low_ranks.size() * sizeof(uint16_t) +
+            m_samples.size() * sizeof(len_t);
+    }
+};
+
+} //ns
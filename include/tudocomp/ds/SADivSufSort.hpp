@@ -10,6 +10,13 @@
 namespace tdc {
 
 /// Constructs the suffix array using divsufsort.
+///
+/// divsufsort runs on the suffix array's storage viewed as a native integer
+/// array, avoiding bit packed accesses and extra memory. Only if the suffix
+/// array is to be compressed during construction and a packed array with a
+/// sign bit saves a considerable amount of memory, divsufsort runs on the
+/// packed array instead. In compressed mode, the array is packed to its
+/// final width in one blocked pass at the end of the construction.
 class SADivSufSort: public Algorithm, public ArrayDS {
 public:
     inline static Meta meta() {
@@ -24,6 +31,10 @@ public:
         };
     }
 
+    inline SADivSufSort(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)) {
+    }
+
     template<typename textds_t>
     inline SADivSufSort(Env&& env, const textds_t& t, CompressMode cm)
         : Algorithm(std::move(env)) {
@@ -34,16 +45,31 @@ public:
             const size_t w = bits_for(n);
 
             // divsufsort needs one additional bit for signs
-            set_array(iv_t(n, 0, (cm == CompressMode::compressed) ? w + 1 : LEN_BITS));
+            const bool packed = (cm == CompressMode::compressed) &&
+                                (LEN_BITS - (w + 1) >= LEN_BITS / 8);
+
+            set_array(iv_t(n, 0, packed ? w + 1 : LEN_BITS));
+
+            // Use divsufsort to construct, on a native array if possible
+            const bool native = !packed && with_native_array([&](native_t* sa) {
+                divsufsort(t.text(), sa, n);
+            });
+
+            if(!native) {
+                divsufsort(t.text(), (iv_t&) *this, n);
+            }
 
-            // Use divsufsort to construct
-            divsufsort(t.text(), (iv_t&) *this, n);
+            if(cm == CompressMode::compressed) {
+                width(w);
+                shrink_to_fit();
+            }
 
+            StatPhase::log("native", native);
             StatPhase::log("bit_width", size_t(width()));
             StatPhase::log("size", bit_size() / 8);
         });
 
-        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+        if(cm == CompressMode::delayed) {
             compress();
         }
     }
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/util/external.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array in external memory using prefix doubling.
+///
+/// In each round, every suffix is named by the pair of names of its prefix
+/// and the prefix behind it. The pairs are sorted and renamed using
+/// external sorting in files in the scratch directory, until all names are
+/// unique. The names are then the ranks of the suffixes, and sorting the
+/// suffixes by them writes the suffix array. Only the sorting and file
+/// buffers are kept in memory, their total size is limited by the option
+/// `memory` (in MiB). The scratch directory is set by the option `scratch`.
+///
+/// The resulting suffix array is provided as a read-only memory mapping of
+/// a scratch file and is not counted as allocated memory. Taking it over
+/// using \ref relinquish or \ref copy loads it into memory.
+class SAExternal: public Algorithm {
+public:
+    /// \brief The data structure's data type.
+    using data_type = DynamicIntVector;
+
+private:
+    struct name_t {
+        len_t pos, name;
+    };
+
+    struct pair_t {
+        len_t name1, name2, pos;
+    };
+
+    struct by_pos {
+        inline bool operator()(const name_t& a, const name_t& b) const {
+            return a.pos < b.pos;
+        }
+    };
+
+    struct by_name {
+        inline bool operator()(const name_t& a, const name_t& b) const {
+            return a.name < b.name;
+        }
+    };
+
+    struct by_names {
+        inline bool operator()(const pair_t& a, const pair_t& b) const {
+            return (a.name1 < b.name1) ||
+                   (a.name1 == b.name1 && a.name2 < b.name2);
+        }
+    };
+
+    external::MappedArray<len_t> m_sa;
+    CompressMode m_cm;
+
+    // constructs the suffix array into a scratch file
+    template<typename textds_t>
+    inline void construct(const textds_t& t, const std::string& dir,
+                          size_t memory, external::TempFile& sa_file) {
+
+        const size_t n = t.size();
+
+        // at most two sorters exist at the same time, each with half of the
+        // memory, while file buffers are used next to one sorter only
+        const size_t sort_memory = memory / 2;
+        const size_t buffer_size = std::min(n, memory / 16 / sizeof(name_t));
+
+        // initial names are the characters, zero is used beyond the text
+        external::TempFile names(dir);
+        {
+            external::Writer<name_t> w(names.path(), buffer_size);
+            for(size_t i = 0; i < n; i++) {
+                w.push(name_t { len_t(i), len_t(t[i]) + 1 });
+            }
+        }
+
+        size_t rounds = 0, runs = 0;
+        for(size_t h = 1;; h *= 2) {
+            ++rounds;
+
+            // pair each name with the name h positions behind
+            external::Sorter<pair_t, by_names> pairs(dir, sort_memory);
+            {
+                external::Reader<name_t> r1(names.path(), buffer_size);
+                external::Reader<name_t> r2(names.path(), buffer_size);
+                for(size_t i = 0; i < h && r2.has_next(); i++) r2.next();
+
+                while(r1.has_next()) {
+                    const name_t x = r1.next();
+                    const len_t name2 = r2.has_next() ? r2.next().name : 0;
+                    pairs.push(pair_t { x.name, name2, x.pos });
+                }
+            }
+            runs += pairs.runs();
+
+            // rename by the rank of the pairs
+            external::Sorter<name_t, by_pos> renamed(dir, sort_memory);
+            bool unique = true;
+            {
+                size_t rank = 0, name = 0;
+                pair_t prev { 0, 0, 0 };
+                pairs.sort([&](const pair_t& x) {
+                    ++rank;
+                    if(rank == 1 || x.name1 != prev.name1 || x.name2 != prev.name2) {
+                        name = rank;
+                    } else {
+                        unique = false;
+                    }
+                    prev = x;
+
+                    renamed.push(name_t { x.pos, len_t(name) });
+                });
+            }
+            runs += renamed.runs();
+
+            if(unique) {
+                // the names are the ranks of the suffixes
+                external::Sorter<name_t, by_name> ranked(dir, sort_memory);
+                renamed.sort([&](const name_t& x) { ranked.push(x); });
+                runs += ranked.runs();
+
+                external::Writer<len_t> sa(sa_file.path(), buffer_size);
+                ranked.sort([&](const name_t& x) { sa.push(x.pos); });
+                break;
+            }
+
+            {
+                external::Writer<name_t> w(names.path(), buffer_size);
+                renamed.sort([&](const name_t& x) { w.push(x); });
+            }
+        }
+
+        StatPhase::log("rounds", rounds);
+        StatPhase::log("runs", runs);
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("sa", "external", "External memory prefix doubling");
+        m.option("scratch").dynamic("/tmp");
+        m.option("memory").dynamic(1024);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {
+            { 0 },
+            true
+        };
+    }
+
+    template<typename textds_t>
+    inline SAExternal(Env&& env, const textds_t& t, CompressMode cm)
+        : Algorithm(std::move(env)), m_cm(cm) {
+
+        const std::string dir = this->env().option("scratch").as_string();
+        const size_t memory = this->env().option("memory").as_integer() << 20ULL;
+
+        StatPhase::wrap("Construct SA", [&]{
+            external::TempFile sa_file(dir);
+            construct(t, dir, memory, sa_file);
+
+            // the mapping persists after the file is removed
+            m_sa = external::MappedArray<len_t>(sa_file.path(), t.size());
+
+            StatPhase::log("size", m_sa.size() * sizeof(len_t));
+        });
+    }
+
+    inline SAExternal(SAExternal&& other) = default;
+    inline SAExternal& operator=(SAExternal&& other) = default;
+
+    /// \brief Accesses the suffix array at position i.
+    inline len_t operator[](size_t i) const {
+        return m_sa[i];
+    }
+
+    /// \brief Yields the size of the suffix array.
+    inline size_t size() const {
+        return m_sa.size();
+    }
+
+    /// \brief Does nothing, the suffix array stays in its scratch file.
+    inline void compress() {
+    }
+
+    /// \brief Creates a copy of the suffix array in memory.
+    ///
+    /// The copy is bit compressed unless the compression mode is plain.
+    inline data_type copy() const {
+        const size_t n = size();
+        data_type iv(n, 0, (m_cm == CompressMode::plain) ? LEN_BITS : bits_for(n));
+        for(size_t i = 0; i < n; i++) iv[i] = m_sa[i];
+        return iv;
+    }
+
+    /// \brief Loads the suffix array into memory and releases the mapping.
+    inline data_type relinquish() {
+        data_type iv = copy();
+        m_sa = external::MappedArray<len_t>();
+        return iv;
+    }
+};
+
+} //ns
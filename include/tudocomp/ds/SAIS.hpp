@@ -0,0 +1,90 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/sais.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array using SA-IS in linear time.
+///
+/// The algorithm works on the suffix array's storage viewed as a native
+/// integer array, and solves the reduced problems in its unused space.
+/// Apart from the suffix array, only bucket arrays for the alphabet are
+/// allocated. With 40 bit positions, the storage is no native array, and
+/// the algorithm works on a separate 64 bit buffer that is copied into it.
+/// The size of that buffer is logged as `buffer`, the peak memory is
+/// reported in the construction phase.
+class SAIS: public Algorithm, public ArrayDS {
+public:
+    inline static Meta meta() {
+        Meta m("sa", "sais", "Linear time SA-IS");
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {
+            { 0 },
+            true
+        };
+    }
+
+    inline SAIS(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)) {
+    }
+
+    template<typename textds_t>
+    inline SAIS(Env&& env, const textds_t& t, CompressMode cm)
+        : Algorithm(std::move(env)) {
+
+        StatPhase::wrap("Construct SA", [&]{
+            // Allocate
+            const size_t n = t.size();
+            DCHECK_LE(n, size_t(std::numeric_limits<native_t>::max()));
+
+            // SA-IS needs signed integers
+            set_array(iv_t(n, 0, LEN_BITS));
+
+            const bool native = with_native_array([&](native_t* sa) {
+                sais::sais(t.text(), sa, native_t(n));
+            });
+
+            if(!native) {
+                std::vector<native_t> buffer(n);
+                sais::sais(t.text(), buffer.data(), native_t(n));
+
+                iv_t& iv = *this;
+                for(size_t i = 0; i < n; i++) iv[i] = buffer[i];
+            }
+
+            StatPhase::log("buffer", native ? size_t(0) : n * sizeof(native_t));
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            compress();
+        }
+    }
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress SA", [this]{
+            width(bits_for(size()));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
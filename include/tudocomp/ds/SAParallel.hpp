@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/ArrayDS.hpp>
+#include <tudocomp/util/parallel.hpp>
+
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+
+/// Constructs the suffix array using parallel prefix doubling.
+///
+/// The suffixes are bucket sorted by their first character in parallel.
+/// Then, in rounds of doubling prefix lengths h, each group of suffixes
+/// sharing a common prefix of length h is sorted by the rank of the suffix
+/// h positions behind. Groups are distributed among the threads, large
+/// groups are sorted by all threads together.
+///
+/// Besides the text, the construction needs the suffix array and the ranks
+/// as native arrays and a bit vector of group starts. The ranks are released
+/// before the result is copied into the packed storage, so the peak memory
+/// is that of two native arrays and n bits.
+///
+/// The option `threads` sets the amount of threads to use, where zero
+/// selects the amount of hardware threads.
+class SAParallel: public Algorithm, public ArrayDS {
+private:
+    struct group_t {
+        len_t begin, end;
+    };
+
+    // group sizes from which all threads sort the group together
+    static constexpr size_t LARGE_GROUP = 1ULL << 16;
+
+    // calls f(thread, group) for all groups, balancing the total size of
+    // the groups assigned to each thread
+    template<typename F>
+    inline static void for_groups(
+        const std::vector<group_t>& groups, size_t threads, F f) {
+
+        std::vector<size_t> start(groups.size() + 1, 0);
+        for(size_t g = 0; g < groups.size(); g++) {
+            start[g + 1] = start[g] + (groups[g].end - groups[g].begin);
+        }
+
+        parallel::for_chunks(start.back(), threads, 1,
+            [&](size_t tid, size_t b, size_t e) {
+                size_t g = std::lower_bound(
+                    start.begin(), start.end() - 1, b) - start.begin();
+                for(; g < groups.size() && start[g] < e; g++) {
+                    f(tid, groups[g]);
+                }
+            });
+    }
+
+    // bucket sorts the suffixes by their first character, sets their rank
+    // to their bucket's start and yields the buckets of size > 1
+    inline static std::vector<group_t> bucket_sort(
+        const uliteral_t* text, size_t n,
+        std::vector<len_t>& sa, std::vector<len_t>& rank, size_t threads) {
+
+        const size_t sigma = ULITERAL_MAX + 1;
+
+        std::vector<std::vector<len_t>> count(
+            threads, std::vector<len_t>(sigma, 0));
+
+        parallel::for_chunks(n, threads, 1, [&](size_t tid, size_t b, size_t e) {
+            for(size_t i = b; i < e; i++) ++count[tid][text[i]];
+        });
+
+        // turn counts into per-thread scatter offsets
+        std::vector<len_t> bucket(sigma + 1, 0);
+        size_t sum = 0;
+        for(size_t c = 0; c < sigma; c++) {
+            bucket[c] = sum;
+            for(size_t tid = 0; tid < threads; tid++) {
+                const len_t x = count[tid][c];
+                count[tid][c] = sum;
+                sum += x;
+            }
+        }
+        bucket[sigma] = sum;
+
+        parallel::for_chunks(n, threads, 1, [&](size_t tid, size_t b, size_t e) {
+            for(size_t i = b; i < e; i++) {
+                const uliteral_t c = text[i];
+                sa[count[tid][c]++] = i;
+                rank[i] = bucket[c];
+            }
+        });
+
+        std::vector<group_t> groups;
+        for(size_t c = 0; c < sigma; c++) {
+            if(bucket[c + 1] - bucket[c] > 1) {
+                groups.push_back(group_t { bucket[c], bucket[c + 1] });
+            }
+        }
+        return groups;
+    }
+
+    // sets the bits [b, e) of a bit vector shared between threads to
+    // flag(j); words shared with other ranges are updated atomically
+    template<typename F>
+    inline static void set_bits(uint64_t* bits, size_t b, size_t e, F flag) {
+        for(size_t j = b; j < e;) {
+            const size_t w = j / 64;
+            const size_t end = std::min(e, (w + 1) * 64);
+
+            uint64_t mask = 0, value = 0;
+            for(; j < end; j++) {
+                mask |= 1ULL << (j % 64);
+                if(flag(j)) value |= 1ULL << (j % 64);
+            }
+
+            if(mask == ~0ULL) {
+                bits[w] = value;
+            } else {
+                __atomic_fetch_and(bits + w, ~mask, __ATOMIC_RELAXED);
+                __atomic_fetch_or(bits + w, value, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    // sorts a group by the ranks h positions behind and marks the first
+    // member of each new group in the bit vector heads
+    inline static void sort_group(
+        const group_t& g, size_t h, size_t threads,
+        std::vector<len_t>& sa, const std::vector<len_t>& rank,
+        uint64_t* heads) {
+
+        const size_t n = sa.size();
+        auto key = [&](len_t s) {
+            DCHECK_LT(s + h, n);
+            return rank[s + h];
+        };
+
+        auto comp = [&](len_t a, len_t b) { return key(a) < key(b); };
+        if(threads > 1) {
+            parallel::sort(sa.begin() + g.begin, sa.begin() + g.end, comp, threads);
+        } else {
+            std::sort(sa.begin() + g.begin, sa.begin() + g.end, comp);
+        }
+
+        set_bits(heads, g.begin, g.end, [&](size_t j) {
+            return j == g.begin || key(sa[j]) != key(sa[j - 1]);
+        });
+    }
+
+    inline static void prefix_doubling(
+        std::vector<group_t> groups,
+        std::vector<len_t>& sa, std::vector<len_t>& rank, size_t threads) {
+
+        // instead of the new ranks, only the group starts are kept until
+        // all groups of a round are sorted
+        std::vector<uint64_t> heads((sa.size() + 63) / 64);
+        std::vector<std::vector<group_t>> next(threads);
+
+        for(size_t h = 1; !groups.empty(); h *= 2) {
+            // sort groups, large groups using all threads
+            std::vector<group_t> small;
+            for(auto& g : groups) {
+                if(threads > 1 && size_t(g.end - g.begin) >= LARGE_GROUP) {
+                    sort_group(g, h, threads, sa, rank, heads.data());
+                } else {
+                    small.push_back(g);
+                }
+            }
+            for_groups(small, threads, [&](size_t, const group_t& g) {
+                sort_group(g, h, 1, sa, rank, heads.data());
+            });
+
+            // update ranks only after all groups were sorted, and collect
+            // the groups that are still unsorted
+            for_groups(groups, threads, [&](size_t tid, const group_t& g) {
+                size_t b = g.begin;
+                for(size_t j = g.begin; j < g.end; j++) {
+                    if((heads[j / 64] >> (j % 64)) & 1ULL) b = j;
+                    rank[sa[j]] = b;
+
+                    const bool last = (j + 1 == g.end) ||
+                        ((heads[(j + 1) / 64] >> ((j + 1) % 64)) & 1ULL);
+                    if(last && j + 1 - b > 1) {
+                        next[tid].push_back(group_t { len_t(b), len_t(j + 1) });
+                    }
+                }
+            });
+
+            groups.clear();
+            for(auto& v : next) {
+                groups.insert(groups.end(), v.begin(), v.end());
+                v.clear();
+            }
+        }
+    }
+
+public:
+    inline static Meta meta() {
+        Meta m("sa", "parallel", "Parallel prefix doubling");
+        m.option("threads").dynamic(0);
+        return m;
+    }
+
+    inline static ds::InputRestrictions restrictions() {
+        return ds::InputRestrictions {
+            { 0 },
+            true
+        };
+    }
+
+    inline SAParallel(Env&& env, iv_t&& data)
+        : Algorithm(std::move(env)), ArrayDS(std::move(data)) {
+    }
+
+    template<typename textds_t>
+    inline SAParallel(Env&& env, const textds_t& t, CompressMode cm)
+        : Algorithm(std::move(env)) {
+
+        const size_t threads = parallel::num_threads(
+            this->env().option("threads").as_integer());
+
+        StatPhase::wrap("Construct SA", [&]{
+            const size_t n = t.size();
+
+            std::vector<len_t> sa(n);
+            {
+                std::vector<len_t> rank(n);
+
+                std::vector<group_t> groups;
+                StatPhase::wrap("Bucket Sort", [&]{
+                    groups = bucket_sort(t.text(), n, sa, rank, threads);
+                });
+                StatPhase::wrap("Prefix Doubling", [&]{
+                    prefix_doubling(std::move(groups), sa, rank, threads);
+                });
+            }
+
+            // The rank array is released, so the packed storage takes its
+            // place. Threads copy word aligned chunks into it.
+            set_array(iv_t(n, 0,
+                (cm == CompressMode::compressed) ? bits_for(n) : LEN_BITS));
+
+            iv_t& iv = *this;
+            parallel::for_chunks(n, threads, 64, [&](size_t, size_t b, size_t e) {
+                for(size_t i = b; i < e; i++) iv[i] = sa[i];
+            });
+
+            StatPhase::log("threads", threads);
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            compress();
+        }
+    }
+
+    void compress() {
+        debug_check_array_is_initialized();
+
+        StatPhase::wrap("Compress SA", [this]{
+            width(bits_for(size()));
+            shrink_to_fit();
+
+            StatPhase::log("bit_width", size_t(width()));
+            StatPhase::log("size", bit_size() / 8);
+        });
+    }
+};
+
+} //ns
@@ -3,8 +3,11 @@
 #include <tudocomp/ds/TextDSFlags.hpp>
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/IntVectorStorage.hpp>
 
 #include <tudocomp/ds/CompressMode.hpp>
+#include <tudocomp/ds/TextDSPlanner.hpp>
+#include <tudocomp/ds/IndexCache.hpp>
 
 //Defaults
 #include <tudocomp/ds/SADivSufSort.hpp>
@@ -69,13 +72,84 @@ private:
 
     dsflags_t m_ds_requested;
     CompressMode m_cm;
+    ds::Objective m_objective;
+
+    std::unique_ptr<ds::IndexCache> m_cache;
+    std::shared_ptr<const int_vector::Storage> m_storage;
+
+    // data structures that can be restored from an array can be cached
+    template<typename ds_t>
+    using cacheable = std::integral_constant<bool,
+        std::is_base_of<ArrayDS, ds_t>::value &&
+        std::is_constructible<ds_t, Env&&, ArrayDS::iv_t&&>::value>;
+
+    // a string identifying the provider of a data structure and its options
+    inline std::string provider(const std::string& option) {
+        std::ostringstream s;
+        s << this->env().option(option);
+        return s.str();
+    }
+
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> load_ds(
+        const std::string&, Env&&, CompressMode, std::false_type) {
+
+        return nullptr;
+    }
+
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> load_ds(
+        const std::string& option, Env&& env, CompressMode cm, std::true_type) {
+
+        ArrayDS::iv_t data;
+        const bool hit = StatPhase::wrap("Load from Cache", [&]{
+            const bool hit = m_cache->load(option, provider(option), data);
+            StatPhase::log("hit", hit);
+            return hit;
+        });
+        if(!hit) return nullptr;
+
+        auto p = std::make_unique<ds_t>(std::move(env), std::move(data));
+        if(cm == CompressMode::compressed || cm == CompressMode::delayed) {
+            p->compress();
+        }
+        return p;
+    }
+
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> construct_ds(
+        const std::string&, Env&& env, CompressMode cm, std::false_type) {
+
+        return std::make_unique<ds_t>(std::move(env), *this, cm);
+    }
+
+    template<typename ds_t>
+    inline std::unique_ptr<ds_t> construct_ds(
+        const std::string& option, Env&& env, CompressMode cm, std::true_type) {
+
+        if(!m_cache) {
+            return construct_ds<ds_t>(option, std::move(env), cm, std::false_type());
+        }
+
+        // the environment is only moved on a hit
+        auto p = load_ds<ds_t>(option, std::move(env), cm, std::true_type());
+        if(!p) {
+            p = construct_ds<ds_t>(option, std::move(env), cm, std::false_type());
+            StatPhase::wrap("Store in Cache", [&]{
+                m_cache->store(option, provider(option), *p);
+            });
+        }
+        return p;
+    }
 
     template<typename ds_t>
     inline std::unique_ptr<ds_t> construct_ds(const std::string& option, CompressMode cm) {
-        return std::make_unique<ds_t>(
+        int_vector::StorageScope scope(m_storage);
+        return construct_ds<ds_t>(
+                    option,
                     env().env_for_option(option),
-                    *this,
-                    cm_select(cm, m_cm));
+                    cm_select(cm, m_cm),
+                    cacheable<ds_t>());
     }
 
     template<typename ds_t>
@@ -86,6 +160,19 @@ private:
         return *p;
     }
 
+    // loads a missing data structure from the cache, without constructing
+    // any of its dependencies
+    template<typename ds_t>
+    inline bool load_cached_ds(
+        std::unique_ptr<ds_t>& p, const std::string& option, CompressMode cm) {
+
+        if(!p && m_cache) {
+            int_vector::StorageScope scope(m_storage);
+            p = load_ds<ds_t>(option, env().env_for_option(option), cm, cacheable<ds_t>());
+        }
+        return bool(p);
+    }
+
     template<typename ds_t>
     inline void discard_ds(std::unique_ptr<ds_t>& p, dsflags_t flag) {
         p.reset(nullptr);
@@ -102,6 +189,8 @@ private:
         std::unique_ptr<ds_t>& p, dsflags_t flag, const std::string& option, CompressMode cm) {
 
         if(!p) p = construct_ds<ds_t>(option, cm_select(cm, m_cm));
+
+        int_vector::StorageScope scope(m_storage);
         if(m_ds_requested & flag) {
             // data structure is requested, return a copy of the data
             return p->copy();
@@ -122,6 +211,10 @@ public:
         m.option("lcp").templated<lcp_t, LCPFromPLCP>("lcp");
         m.option("isa").templated<isa_t, ISAFromSA>("isa");
         m.option("compress").dynamic("delayed");
+        m.option("plan").dynamic("time");
+        m.option("cache").dynamic("none");
+        m.option("storage").dynamic("heap");
+        m.option("scratch").dynamic("/tmp");
         return m;
     }
 
@@ -137,6 +230,14 @@ public:
             );
         }
 
+        if(m_text.size() > LEN_MAX) {
+            throw std::logic_error(
+                "Input is too large for text positions of " +
+                std::to_string(LEN_BITS) + " bits! Please configure the "
+                "build with `-DLEN_BITS=40` or `-DLEN_BITS=64`."
+            );
+        }
+
         auto& cm_str = this->env().option("compress").as_string();
         if(cm_str == "delayed") {
             m_cm = CompressMode::delayed;
@@ -145,6 +246,23 @@ public:
         } else {
             m_cm = CompressMode::plain;
         }
+
+        auto& cache_dir = this->env().option("cache").as_string();
+        if(cache_dir != "none") {
+            m_cache = std::make_unique<ds::IndexCache>(
+                cache_dir, m_text.data(), m_text.size());
+        }
+
+        auto& plan_str = this->env().option("plan").as_string();
+        if(plan_str == "memory") {
+            m_objective = ds::Objective::memory;
+        } else {
+            m_objective = ds::Objective::time;
+        }
+
+        m_storage = int_vector::Storage::parse(
+            this->env().option("storage").as_string(),
+            this->env().option("scratch").as_string());
     }
 
     inline TextDS(Env&& env, const View& text, dsflags_t flags, CompressMode cm = CompressMode::select)
@@ -234,61 +352,104 @@ private:
         discard_ds(m_isa, ISA);
     }
 
-    inline void discard_unneeded() {
-        // discard unrequested structures
-        if(!(m_ds_requested & SA)) discard_sa();
-        if(!(m_ds_requested & PHI)) discard_phi();
-        if(!(m_ds_requested & PLCP)) discard_plcp();
-        if(!(m_ds_requested & LCP)) discard_lcp();
-        if(!(m_ds_requested & ISA)) discard_isa();
+    // yields the given data structures that are present or were loaded
+    // from the cache
+    inline dsflags_t load_cached(dsflags_t flags, CompressMode cm) {
+        dsflags_t present = 0;
+        if((flags & SA)   && load_cached_ds(m_sa, "sa", cm))     present |= SA;
+        if((flags & PHI)  && load_cached_ds(m_phi, "phi", cm))   present |= PHI;
+        if((flags & PLCP) && load_cached_ds(m_plcp, "plcp", cm)) present |= PLCP;
+        if((flags & LCP)  && load_cached_ds(m_lcp, "lcp", cm))   present |= LCP;
+        if((flags & ISA)  && load_cached_ds(m_isa, "isa", cm))   present |= ISA;
+        return present;
+    }
+
+    inline void construct(dsflags_t flag, CompressMode cm) {
+        switch(flag) {
+            case SA:   require_sa(cm);   break;
+            case PHI:  require_phi(cm);  break;
+            case PLCP: require_plcp(cm); break;
+            case LCP:  require_lcp(cm);  break;
+            case ISA:  require_isa(cm);  break;
+        }
+    }
+
+    inline void compress(dsflags_t flags) {
+        if((flags & SA)   && m_sa)   m_sa->compress();
+        if((flags & PHI)  && m_phi)  m_phi->compress();
+        if((flags & PLCP) && m_plcp) m_plcp->compress();
+        if((flags & LCP)  && m_lcp)  m_lcp->compress();
+        if((flags & ISA)  && m_isa)  m_isa->compress();
+    }
+
+    inline void discard(dsflags_t flags) {
+        if(flags & SA)   discard_sa();
+        if(flags & PHI)  discard_phi();
+        if(flags & PLCP) discard_plcp();
+        if(flags & LCP)  discard_lcp();
+        if(flags & ISA)  discard_isa();
     }
 
 public:
+    /// \brief Yields the dependencies of the data structures' providers.
+    inline static std::vector<ds::Dependency> dependencies() {
+        return {
+            ds::Dependency::of<sa_t>(SA),
+            ds::Dependency::of<phi_t>(PHI),
+            ds::Dependency::of<plcp_t>(PLCP),
+            ds::Dependency::of<lcp_t>(LCP),
+            ds::Dependency::of<isa_t>(ISA),
+        };
+    }
+
+    /// \brief Plans the construction of the given data structures.
+    ///
+    /// See \ref ds::plan.
+    inline ds::Plan plan(dsflags_t flags, CompressMode cm = CompressMode::select) const {
+        return ds::plan(flags, dependencies(), cm_select(cm, m_cm), m_objective, size());
+    }
+
+    /// \brief Constructs the given data structures and discards all others.
+    ///
+    /// The construction follows a plan that minimizes the peak memory, the
+    /// option `plan` selects whether to compress data structures as early
+    /// as possible (`memory`) or after their dependents have been
+    /// constructed (`time`). The plan and its predicted peak memory are
+    /// logged in the statistics phase of the construction.
+    ///
+    /// Requested data structures that are already present or found in the
+    /// cache are not planned, so their dependencies are not constructed.
     inline void require(dsflags_t flags, CompressMode cm = CompressMode::select) {
         m_ds_requested = flags;
-
-        // TODO: we need something like a dependency graph here
-
-        // construct requested structures
-        cm = cm_select(cm,(m_cm == CompressMode::delayed ?
-                                        CompressMode::coherent_delayed : m_cm));
-
-
-        // Construct SA (don't compress yet)
-        if(flags & SA) { require_sa(cm); discard_unneeded(); }
-
-        // Construct Phi (don't compress yet)
-        if(flags & PHI) { require_phi(cm); discard_unneeded(); }
-
-        // Construct PLCP and compress if LCP is not requested
-        if(flags & PLCP) {
-            require_plcp(cm);
-            discard_unneeded();
-            if(cm == CompressMode::coherent_delayed && !(flags & LCP)) {
-                m_plcp->compress();
+        cm = cm_select(cm, m_cm);
+
+        // compression of delayed structures is done by the plan
+        const CompressMode construct_cm =
+            (cm == CompressMode::delayed) ? CompressMode::coherent_delayed : cm;
+
+        StatPhase::wrap("Construct Text DS", [&]{
+            const dsflags_t present = load_cached(flags, construct_cm);
+            const ds::Plan p = plan(flags & ~present, cm);
+
+            StatPhase::log("plan", p.to_string());
+            StatPhase::log("predicted_peak", p.peak);
+
+            // discard structures of previous requests that are not needed
+            dsflags_t planned = flags;
+            for(auto& step : p.steps) planned |= step.construct;
+            discard(~planned);
+
+            dsflags_t compressed = 0;
+            for(auto& step : p.steps) {
+                construct(step.construct, construct_cm);
+                compress(step.compress);
+                compressed |= step.compress;
+                // present structures may be dependencies of the plan
+                discard(step.discard & ~flags);
             }
-        }
-
-        // Construct and compress LCP
-        if(flags & LCP)  {
-            require_lcp(cm);
-            discard_unneeded();
-            if(cm == CompressMode::coherent_delayed) m_lcp->compress();
-        }
 
-        // Construct and compress ISA
-        if(flags & ISA)  {
-            require_isa(cm);
-            discard_unneeded();
-            if(cm == CompressMode::coherent_delayed) m_isa->compress();
-        }
-
-        // Compress data structures that had dependencies
-        if(cm == CompressMode::coherent_delayed) {
-            if(m_sa) m_sa->compress();
-            if(m_phi) m_phi->compress();
-            if(m_plcp) m_plcp->compress();
-        }
+            if(cm == CompressMode::delayed) compress(present & ~compressed);
+        });
     }
 
     /// Accesses the input text at position i.
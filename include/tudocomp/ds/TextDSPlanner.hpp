@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <tudocomp/ds/TextDSFlags.hpp>
+#include <tudocomp/ds/CompressMode.hpp>
+
+namespace tdc {
+namespace ds {
+
+/// \cond INTERNAL
+template<typename ds_t>
+inline auto needs_of(int) -> decltype(ds_t::dependencies()) {
+    return ds_t::dependencies();
+}
+template<typename ds_t>
+inline dsflags_t needs_of(long) {
+    return NONE;
+}
+
+template<typename ds_t>
+inline auto inplace_of(int) -> decltype(ds_t::inplace_dependencies()) {
+    return ds_t::inplace_dependencies();
+}
+template<typename ds_t>
+inline dsflags_t inplace_of(long) {
+    return NONE;
+}
+
+template<typename ds_t>
+inline auto retained_of(int) -> decltype(ds_t::retained_dependencies()) {
+    return ds_t::retained_dependencies();
+}
+template<typename ds_t>
+inline dsflags_t retained_of(long) {
+    return NONE;
+}
+/// \endcond
+
+/// \brief Describes which data structures a provider needs.
+struct Dependency {
+    /// The provided data structure.
+    dsflags_t flag;
+
+    /// The data structures needed during construction.
+    dsflags_t needs;
+
+    /// The needed data structures whose storage is taken over if they
+    /// have not been requested themselves.
+    dsflags_t inplace;
+
+    /// The needed data structures that are accessed after construction,
+    /// and thus may not be discarded.
+    dsflags_t retained;
+
+    /// \brief Yields the dependencies declared by a provider.
+    ///
+    /// Providers declare them using the static functions `dependencies()`,
+    /// `inplace_dependencies()` and `retained_dependencies()`, if they have
+    /// any.
+    template<typename ds_t>
+    inline static Dependency of(dsflags_t flag) {
+        const dsflags_t inplace = inplace_of<ds_t>(0);
+        const dsflags_t retained = retained_of<ds_t>(0);
+        return Dependency { flag, needs_of<ds_t>(0) | inplace | retained,
+                            inplace, retained };
+    }
+};
+
+/// \brief The goal of a construction plan.
+enum class Objective {
+    /// Compresses data structures right after their construction.
+    memory,
+
+    /// Compresses data structures only after all their dependents have
+    /// been constructed, so these can access them uncompressed.
+    time,
+};
+
+/// \brief A plan for constructing text data structures.
+struct Plan {
+    struct Step {
+        /// The data structure to construct.
+        dsflags_t construct;
+
+        /// The data structures to compress after construction.
+        dsflags_t compress;
+
+        /// The data structures to discard after construction.
+        dsflags_t discard;
+    };
+
+    std::vector<Step> steps;
+
+    /// The predicted peak memory of the data structures in bytes.
+    size_t peak;
+
+    /// \brief Yields the names of the constructed data structures in order.
+    inline std::string to_string() const {
+        std::string s;
+        for(auto& step : steps) {
+            if(!s.empty()) s += ' ';
+            s += name(step.construct);
+        }
+        return s;
+    }
+
+    /// \brief Yields the name of a data structure.
+    inline static const char* name(dsflags_t flag) {
+        switch(flag) {
+            case SA:   return "SA";
+            case ISA:  return "ISA";
+            case LCP:  return "LCP";
+            case PHI:  return "PHI";
+            case PLCP: return "PLCP";
+            default:   return "?";
+        }
+    }
+};
+
+/// \brief Plans the construction of the requested data structures and
+///        their dependencies.
+///
+/// All construction orders that respect the dependencies are simulated,
+/// assuming each data structure is an array of n integers. Its width is
+/// LEN_BITS when uncompressed and bits_for(n) when compressed. Data
+/// structures that have not been requested are discarded as soon as no
+/// other data structure needs them. The order with the smallest peak is
+/// chosen, ties are broken by the order of the dependencies.
+///
+/// \param requested The requested data structures.
+/// \param deps The dependencies of each data structure's provider.
+/// \param cm The compression mode. With `delayed`, the points of
+///           compression are chosen according to the objective.
+/// \param objective The goal of the plan.
+/// \param n The length of the text.
+inline Plan plan(dsflags_t requested, const std::vector<Dependency>& deps,
+                 CompressMode cm, Objective objective, size_t n) {
+
+    auto dep = [&](dsflags_t flag) -> const Dependency& {
+        for(auto& d : deps) if(d.flag == flag) return d;
+        throw std::logic_error("no provider for requested data structure");
+    };
+
+    // close the requested data structures under dependencies
+    dsflags_t needed = requested;
+    for(bool changed = true; changed;) {
+        changed = false;
+        for(auto& d : deps) {
+            if((needed & d.flag) && (needed | d.needs) != needed) {
+                needed |= d.needs;
+                changed = true;
+            }
+        }
+    }
+
+    // retained data structures are kept like requested ones
+    dsflags_t kept = requested;
+    for(auto& d : deps) if(needed & d.flag) kept |= d.retained;
+
+    const size_t plain_bits = LEN_BITS;
+    const size_t packed_bits = bits_for(n);
+    const size_t construct_bits =
+        (cm == CompressMode::compressed) ? packed_bits : plain_bits;
+
+    // simulates an order and yields its plan
+    auto simulate = [&](const std::vector<dsflags_t>& order) {
+        Plan p { {}, 0 };
+
+        std::vector<size_t> bits(deps.size(), 0);
+        auto index = [&](dsflags_t flag) {
+            for(size_t i = 0; i < deps.size(); i++) if(deps[i].flag == flag) return i;
+            return deps.size();
+        };
+        auto total = [&]() {
+            size_t sum = 0;
+            for(auto b : bits) sum += b;
+            return sum * n / 8;
+        };
+        auto needed_after = [&](size_t k) {
+            dsflags_t f = NONE;
+            for(size_t j = k + 1; j < order.size(); j++) f |= dep(order[j]).needs;
+            return f;
+        };
+
+        dsflags_t compressed = NONE;
+        for(size_t k = 0; k < order.size(); k++) {
+            const Dependency& d = dep(order[k]);
+            Plan::Step step { d.flag, NONE, NONE };
+
+            // take over storage or allocate
+            size_t b = construct_bits;
+            bool taken = false;
+            for(auto& y : deps) {
+                if((d.inplace & y.flag) && !(kept & y.flag) && bits[index(y.flag)]) {
+                    b = bits[index(y.flag)];
+                    bits[index(y.flag)] = 0;
+                    taken = true;
+                    break;
+                }
+            }
+            bits[index(d.flag)] = b;
+            if(!taken) p.peak = std::max(p.peak, total());
+
+            // compress and discard
+            const dsflags_t later = needed_after(k);
+            for(auto& y : deps) {
+                const size_t i = index(y.flag);
+                if(!bits[i]) continue;
+
+                if(!(later & y.flag) && !(kept & y.flag)) {
+                    step.discard |= y.flag;
+                    bits[i] = 0;
+                } else if(cm == CompressMode::delayed && !(compressed & y.flag) &&
+                          (objective == Objective::memory || !(later & y.flag))) {
+                    step.compress |= y.flag;
+                    compressed |= y.flag;
+                    bits[i] = packed_bits;
+                }
+            }
+
+            p.steps.push_back(step);
+        }
+        return p;
+    };
+
+    // enumerate the orders respecting the dependencies
+    Plan best { {}, SIZE_MAX };
+    std::vector<dsflags_t> order;
+    std::function<void(dsflags_t)> enumerate = [&](dsflags_t done) {
+        if(done == needed) {
+            Plan p = simulate(order);
+            if(p.peak < best.peak) best = std::move(p);
+            return;
+        }
+        for(auto& d : deps) {
+            if((needed & d.flag) && !(done & d.flag) &&
+               (done & d.needs) == d.needs) {
+
+                order.push_back(d.flag);
+                enumerate(done | d.flag);
+                order.pop_back();
+            }
+        }
+    };
+    enumerate(NONE);
+
+    if(best.peak == SIZE_MAX) {
+        throw std::logic_error("cyclic dependencies of text data structures");
+    }
+    return best;
+}
+
+}} //ns
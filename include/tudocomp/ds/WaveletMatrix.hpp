@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp/util.hpp>
+
+namespace tdc {
+
+/// \brief A wavelet matrix over a sequence of literals.
+///
+/// Supports counting the occurrences of a literal in a prefix of the
+/// sequence (rank), and enumerating the distinct literals of a range along
+/// with their ranks at the range's borders. Each level's bit vector stores
+/// the amount of set bits before every block of 512 bits, so the matrix
+/// takes about 1.07 n log(sigma) bits.
+class WaveletMatrix {
+private:
+    static constexpr size_t BLOCK_WORDS = 8;
+
+    struct level_t {
+        std::vector<uint64_t> bits;
+        std::vector<len_t> blocks;
+        len_t zeros;
+
+        inline bool get(size_t i) const {
+            return (bits[i / 64] >> (i % 64)) & 1ULL;
+        }
+
+        inline size_t rank1(size_t i) const {
+            const size_t w = i / 64;
+            size_t r = blocks[w / BLOCK_WORDS];
+            for(size_t k = (w / BLOCK_WORDS) * BLOCK_WORDS; k < w; k++) {
+                r += __builtin_popcountll(bits[k]);
+            }
+            if(i % 64) r += __builtin_popcountll(bits[w] & ((1ULL << (i % 64)) - 1));
+            return r;
+        }
+
+        inline size_t rank0(size_t i) const {
+            return i - rank1(i);
+        }
+    };
+
+    size_t m_size = 0;
+    std::vector<level_t> m_levels;
+
+    // the start of each literal's range at the bottom level
+    std::array<len_t, ULITERAL_MAX + 1> m_start;
+
+    template<typename F>
+    inline void for_each_symbol(size_t level, size_t b, size_t e,
+                                size_t c, F& f) const {
+        if(level == m_levels.size()) {
+            f(uliteral_t(c), len_t(b - m_start[c]), len_t(e - m_start[c]));
+            return;
+        }
+
+        const level_t& lv = m_levels[level];
+        const size_t b0 = lv.rank0(b), e0 = lv.rank0(e);
+        if(b0 < e0) {
+            for_each_symbol(level + 1, b0, e0, c << 1, f);
+        }
+        const size_t b1 = lv.zeros + (b - b0), e1 = lv.zeros + (e - e0);
+        if(b1 < e1) {
+            for_each_symbol(level + 1, b1, e1, (c << 1) | 1, f);
+        }
+    }
+
+public:
+    inline WaveletMatrix() {}
+
+    /// \brief Constructs the wavelet matrix of a sequence of literals.
+    ///
+    /// The sequence is consumed, its contents are undefined afterwards.
+    inline WaveletMatrix(std::vector<uliteral_t>& seq) : m_size(seq.size()) {
+        const size_t n = seq.size();
+
+        uliteral_t max = 0;
+        for(auto c : seq) max = std::max(max, c);
+        const size_t height = bits_for(max);
+
+        const size_t words = n / 64 + 1;
+        const size_t blocks = words / BLOCK_WORDS + 1;
+
+        std::vector<uliteral_t> tmp(n);
+        m_levels.resize(height);
+        for(size_t l = 0; l < height; l++) {
+            const size_t shift = height - 1 - l;
+            level_t& lv = m_levels[l];
+            lv.bits.assign(words, 0);
+            lv.blocks.assign(blocks, 0);
+
+            // stable partition by the level's bit, zeros first
+            size_t zeros = 0;
+            for(size_t i = 0; i < n; i++) {
+                if((seq[i] >> shift) & 1) {
+                    lv.bits[i / 64] |= 1ULL << (i % 64);
+                } else {
+                    ++zeros;
+                }
+            }
+            lv.zeros = zeros;
+
+            size_t z = 0, o = zeros;
+            for(size_t i = 0; i < n; i++) {
+                if((seq[i] >> shift) & 1) tmp[o++] = seq[i];
+                else tmp[z++] = seq[i];
+            }
+            std::swap(seq, tmp);
+
+            size_t ones = 0;
+            for(size_t w = 0; w < words; w++) {
+                if(w % BLOCK_WORDS == 0) lv.blocks[w / BLOCK_WORDS] = ones;
+                ones += __builtin_popcountll(lv.bits[w]);
+            }
+        }
+
+        // literals are sorted by their reversed bits at the bottom level
+        m_start.fill(0);
+        for(size_t c = 0; c <= ULITERAL_MAX; c++) {
+            size_t i = 0;
+            if((c >> height) == 0) {
+                for(size_t l = 0; l < height; l++) {
+                    const level_t& lv = m_levels[l];
+                    i = ((c >> (height - 1 - l)) & 1)
+                        ? lv.zeros + lv.rank1(i)
+                        : lv.rank0(i);
+                }
+            }
+            m_start[c] = i;
+        }
+    }
+
+    /// \brief Yields the amount of occurrences of c in the range [0, i).
+    inline len_t rank(uliteral_t c, size_t i) const {
+        if((size_t(c) >> m_levels.size()) != 0) return 0;
+
+        const size_t height = m_levels.size();
+        for(size_t l = 0; l < height; l++) {
+            const level_t& lv = m_levels[l];
+            i = ((c >> (height - 1 - l)) & 1)
+                ? lv.zeros + lv.rank1(i)
+                : lv.rank0(i);
+        }
+        return i - m_start[c];
+    }
+
+    /// \brief Calls `f(c, rank(c, b), rank(c, e))` for each distinct literal
+    ///        c in the range [b, e).
+    template<typename F>
+    inline void for_each_symbol(size_t b, size_t e, F f) const {
+        if(b < e) for_each_symbol(0, b, e, 0, f);
+    }
+
+    /// \brief Accesses the literal at position i.
+    inline uliteral_t operator[](size_t i) const {
+        size_t c = 0;
+        for(auto& lv : m_levels) {
+            const bool bit = lv.get(i);
+            c = (c << 1) | bit;
+            i = bit ? lv.zeros + lv.rank1(i) : lv.rank0(i);
+        }
+        return uliteral_t(c);
+    }
+
+    /// \brief Yields the length of the sequence.
+    inline size_t size() const {
+        return m_size;
+    }
+};
+
+} //ns
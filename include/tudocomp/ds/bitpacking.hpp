@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace tdc {
+namespace int_vector {
+
+/// \brief Bulk conversion between bit packed and unpacked integers.
+///
+/// Integers of width `w` are packed back to back starting at the least
+/// significant bit of the first word, as in \ref BitPackingVector. A block
+/// of \ref BLOCK integers thus occupies exactly `w` words and starts on a
+/// word boundary, so blocks can be converted independently of each other.
+/// Full blocks are handled by completely unrolled routines specialized for
+/// each width, where all shifts and masks are constants.
+namespace bulk {
+
+/// \brief The number of integers in a block.
+constexpr size_t BLOCK = 64;
+
+/// \cond INTERNAL
+constexpr uint64_t mask(size_t w) {
+    return (w >= 64) ? ~0ULL : ((1ULL << w) - 1);
+}
+
+using block_fn = void (*)(const uint64_t*, uint64_t*);
+
+template<size_t W>
+inline void unpack_block(const uint64_t* __restrict in, uint64_t* __restrict out) {
+    uint64_t cur = (W > 0) ? in[0] : 0;
+#pragma GCC unroll 64
+    for(size_t i = 0; i < BLOCK; i++) {
+        const size_t offset = (i * W) % 64;
+
+        uint64_t v = cur >> offset;
+        if(offset + W >= 64 && i + 1 < BLOCK) {
+            cur = in[(i * W) / 64 + 1];
+            if(offset + W > 64) v |= cur << ((64 - offset) % 64);
+        }
+        out[i] = v & mask(W);
+    }
+}
+
+template<size_t W>
+inline void pack_block(const uint64_t* __restrict in, uint64_t* __restrict out) {
+    uint64_t acc = 0;
+#pragma GCC unroll 64
+    for(size_t i = 0; i < BLOCK; i++) {
+        const size_t offset = (i * W) % 64;
+        const uint64_t v = in[i] & mask(W);
+
+        acc |= v << offset;
+        if(offset + W >= 64) {
+            *out++ = acc;
+            acc = (offset + W > 64) ? (v >> ((64 - offset) % 64)) : 0;
+        }
+    }
+}
+
+template<size_t... W>
+inline const block_fn* unpack_table(std::index_sequence<W...>) {
+    static const block_fn table[] = { &unpack_block<W>... };
+    return table;
+}
+
+template<size_t... W>
+inline const block_fn* pack_table(std::index_sequence<W...>) {
+    static const block_fn table[] = { &pack_block<W>... };
+    return table;
+}
+
+inline void unpack_any(const uint64_t* in, uint8_t w, uint64_t* out, size_t n) {
+    for(size_t i = 0; i < n; i++) {
+        const size_t bit = i * w;
+        const size_t word = bit / 64;
+        const size_t offset = bit % 64;
+
+        uint64_t v = in[word] >> offset;
+        if(offset + w > 64) v |= in[word + 1] << (64 - offset);
+        out[i] = v & mask(w);
+    }
+}
+
+inline void pack_any(const uint64_t* in, uint8_t w, uint64_t* out, size_t n) {
+    uint64_t acc = 0;
+    size_t offset = 0;
+    for(size_t i = 0; i < n; i++) {
+        const uint64_t v = in[i] & mask(w);
+
+        acc |= v << offset;
+        if(offset + w >= 64) {
+            *out++ = acc;
+            acc = (offset + w > 64) ? (v >> (64 - offset)) : 0;
+        }
+        offset = (offset + w) % 64;
+    }
+    if(offset > 0) *out = acc;
+}
+/// \endcond
+
+/// \brief The largest width with specialized routines.
+///
+/// Each specialization adds to the compile time of every translation unit
+/// that changes widths, so only the widths common for text data structures
+/// are covered. Blocks of larger widths other than 64 are converted by a
+/// generic loop, which takes a few times as long.
+constexpr uint8_t MAX_SPECIALIZED = 32;
+
+/// \brief Unpacks a block of \ref BLOCK integers of width \c w.
+///
+/// \param in The `w` words of the block.
+/// \param w The width of the integers, at most 64.
+/// \param out Receives the integers.
+inline void unpack(const uint64_t* in, uint8_t w, uint64_t* out) {
+    if(w <= MAX_SPECIALIZED) {
+        unpack_table(std::make_index_sequence<MAX_SPECIALIZED + 1>())[w](in, out);
+    } else if(w == 64) {
+        std::copy(in, in + BLOCK, out);
+    } else {
+        unpack_any(in, w, out, BLOCK);
+    }
+}
+
+/// \brief Packs a block of \ref BLOCK integers into width \c w.
+///
+/// Only the lowest `w` bits of each integer are stored.
+///
+/// \param in The integers.
+/// \param w The width of the integers, at most 64.
+/// \param out Receives the `w` words of the block.
+inline void pack(const uint64_t* in, uint8_t w, uint64_t* out) {
+    if(w <= MAX_SPECIALIZED) {
+        pack_table(std::make_index_sequence<MAX_SPECIALIZED + 1>())[w](in, out);
+    } else if(w == 64) {
+        std::copy(in, in + BLOCK, out);
+    } else {
+        pack_any(in, w, out, BLOCK);
+    }
+}
+
+/// \brief Unpacks the first \c n integers of width \c w of a block.
+///
+/// Only the words occupied by these integers are read.
+inline void unpack(const uint64_t* in, uint8_t w, uint64_t* out, size_t n) {
+    if(n == BLOCK) unpack(in, w, out);
+    else unpack_any(in, w, out, n);
+}
+
+/// \brief Packs \c n integers into width \c w, starting a block.
+///
+/// Only the words occupied by these integers are written, unused bits of
+/// the last word are cleared.
+inline void pack(const uint64_t* in, uint8_t w, uint64_t* out, size_t n) {
+    if(n == BLOCK) pack(in, w, out);
+    else pack_any(in, w, out, n);
+}
+
+/// \brief Changes the width of \c n packed integers in place.
+///
+/// Integers are truncated to their lowest `to` bits. The storage must
+/// provide room for `n` integers of the larger width.
+///
+/// \param data The packed integers.
+/// \param n The number of integers.
+/// \param from The current width.
+/// \param to The new width.
+inline void repack(uint64_t* data, size_t n, uint8_t from, uint8_t to) {
+    if(from == to) return;
+
+    // A block is unpacked completely before it is packed, and the storage
+    // of a block in the smaller width never reaches into the following
+    // blocks in the larger width. Hence, shrinking goes from front to back
+    // and growing from back to front.
+    uint64_t buf[BLOCK];
+    auto convert = [&](size_t b, size_t k) {
+        unpack(data + b * from, from, buf, k);
+        pack(buf, to, data + b * to, k);
+    };
+
+    const size_t blocks = n / BLOCK;
+    const size_t rest = n % BLOCK;
+    if(from > to) {
+        for(size_t b = 0; b < blocks; b++) convert(b, BLOCK);
+        if(rest > 0) convert(blocks, rest);
+    } else {
+        if(rest > 0) convert(blocks, rest);
+        for(size_t b = blocks; b > 0; b--) convert(b - 1, BLOCK);
+    }
+}
+
+}}} //ns
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <vector>
 #include <tudocomp/util/View.hpp>
+#include <tudocomp/util/parallel.hpp>
 #include <tudocomp/util.hpp>
 #include <tudocomp/def.hpp>
 
@@ -92,5 +95,102 @@ uliteral_t* decode_bwt(const bwt_t& bwt) {
 	return decoded_string;
 }
 
+/**
+ * Computes the LF table of a BWT using the given amount of threads
+ * Each thread counts the characters of a chunk of the BWT, from which the
+ * chunk's offsets into the LF table are derived
+ */
+template<typename bwt_t>
+std::vector<len_t> compute_LF_parallel(const bwt_t& bwt, const size_t bwt_length, const size_t threads) {
+	using counts_t = std::array<len_t, ULITERAL_MAX+1>;
+	const size_t p = std::max(std::min(threads, bwt_length / (size_t(1) << 16)), size_t(1));
+	std::vector<counts_t> counts(p);
+
+	// chunks are taken in the same order in both passes
+	parallel::for_chunks(bwt_length, p, 1, [&](size_t t, size_t b, size_t e) {
+		counts_t& C = counts[t];
+		C.fill(0);
+		for(size_t i = b; i < e; ++i) ++C[literal2int(bwt[i])];
+	});
+
+	len_t sum = 0;
+	for(size_t c = 0; c <= ULITERAL_MAX; ++c) {
+		for(size_t t = 0; t < p; ++t) {
+			const len_t count = counts[t][c];
+			counts[t][c] = sum;
+			sum += count;
+		}
+	}
+	DCHECK_EQ(sum, bwt_length);
+
+	std::vector<len_t> LF(bwt_length);
+	parallel::for_chunks(bwt_length, p, 1, [&](size_t t, size_t b, size_t e) {
+		counts_t& C = counts[t];
+		for(size_t i = b; i < e; ++i) LF[i] = C[literal2int(bwt[i])]++;
+	});
+	return LF;
+}
+
+/**
+ * Decodes a BWT in parallel given the positions of sampled suffixes in the
+ * suffix array, i.e., rows[j] = ISA[(j+1) * step] for all (j+1) * step < n-1
+ * The text is split at the sampled suffixes into segments that are decoded
+ * concurrently. Each thread walks several segments in an interleaved
+ * fashion, prefetching the next LF entries, to hide the memory latency
+ */
+template<typename bwt_t>
+uliteral_t* decode_bwt_sampled(const bwt_t& bwt, const std::vector<len_t>& rows, const size_t step, const size_t threads) {
+	// the amount of segments a thread walks at the same time
+	constexpr size_t INTERLEAVE = 8;
+
+	const size_t bwt_length = bwt.size();
+	if(tdc_unlikely(bwt_length == 0)) return nullptr;
+
+	const size_t segments = rows.size() + 1;
+	DCHECK_GT(step, 0U);
+	DCHECK_EQ(rows.size(), (bwt_length >= 2) ? (bwt_length - 2) / step : 0);
+
+	const std::vector<len_t> LF = compute_LF_parallel(bwt, bwt_length, threads);
+
+	uliteral_t*const decoded_string = new uliteral_t[bwt_length];
+	decoded_string[bwt_length-1] = 0;
+
+	// segment j ends at the suffix sampled in rows[j], the last segment
+	// ends at the terminator, whose suffix comes first
+	parallel::for_chunks(segments, threads, 1, [&](size_t, size_t b, size_t e) {
+		struct cursor_t {
+			size_t row, pos, begin;
+		};
+
+		for(size_t first = b; first < e; first += INTERLEAVE) {
+			const size_t last = std::min(first + INTERLEAVE, e);
+
+			cursor_t cursors[INTERLEAVE];
+			size_t active = 0;
+			for(size_t j = first; j < last; ++j) {
+				const size_t end = (j + 1 < segments) ? (j + 1) * step : bwt_length - 1;
+				cursors[active++] = cursor_t { (j + 1 < segments) ? rows[j] : 0, end, j * step };
+			}
+
+			while(active > 0) {
+				for(size_t k = 0; k < active;) {
+					cursor_t& x = cursors[k];
+					if(x.pos == x.begin) {
+						x = cursors[--active];
+						continue;
+					}
+					decoded_string[--x.pos] = bwt[x.row];
+					x.row = LF[x.row];
+					__builtin_prefetch(&LF[x.row]);
+					__builtin_prefetch(&bwt[x.row]);
+					++k;
+				}
+			}
+		}
+	});
+
+	return decoded_string;
+}
+
 }}//ns
 
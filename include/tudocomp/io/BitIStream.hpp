@@ -5,6 +5,10 @@
 #include <iostream>
 #include <tudocomp/util.hpp>
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 namespace tdc {
 namespace io {
 
@@ -116,12 +120,152 @@ public:
     ///         order.
     template<class T>
     inline T read_int(size_t amount = sizeof(T) * CHAR_BIT) {
-        T value = 0;
-        for(size_t i = 0; i < amount; i++) {
-            value <<= 1;
-            value |= read_bit();
+        uint64_t value = 0;
+        while(amount > 0) {
+            if(m_is_final) {
+                // the last bytes need to be checked for EOF bitwise
+                for(; amount > 0; --amount) {
+                    value <<= 1;
+                    value |= read_bit();
+                }
+                break;
+            }
+
+            // consume the buffered byte chunk-wise instead of bit by bit
+            const size_t avail = size_t(m_cursor) + 1;
+            const size_t take = std::min(avail, amount);
+            amount -= take;
+
+            value = (value << take) |
+                ((m_current >> (avail - take)) & ((1U << take) - 1U));
+
+            if(take == avail) {
+                read_next();
+            } else {
+                m_cursor -= take;
+            }
+        }
+        return T(value);
+    }
+
+    /// \brief Reads a sequence of bytes.
+    ///
+    /// The result is the same as calling \ref read_int with a width of eight
+    /// bits for every byte. If the stream is byte aligned, all but the last
+    /// two bytes are copied from the underlying stream in one block, which
+    /// leaves the final bytes, that may hold the end marker, to
+    /// \ref read_int.
+    ///
+    /// \param out Pointer to the first byte to write to.
+    /// \param n The amount of bytes to read.
+    inline void read_bytes(uint8_t* out, size_t n) {
+        size_t i = 0;
+        if(m_cursor == 7 && !m_is_final && n > 2) {
+            const size_t m = n - 2; // the amount of bytes to copy
+
+            // the buffered bytes come first
+            out[0] = m_current;
+            if(m > 1) {
+                out[1] = m_next;
+
+                // the byte after the copied ones becomes the next buffered one
+                m_stream.read((char*) out + 2, std::streamsize(m - 1));
+                if(size_t(m_stream.gcount()) != m - 1) {
+                    // truncated input
+                    std::fill(out + 2 + m_stream.gcount(), out + n, uint8_t(0));
+                    m_current = m_next = 0;
+                    m_is_final = true;
+                    m_final_bits = 0;
+                    return;
+                }
+                m_next = out[m];
+            }
+            read_next();
+            i = m;
+        }
+
+        for(; i < n; ++i) {
+            out[i] = read_int<uint8_t>(8);
+        }
+    }
+
+    /// \brief Reads a sequence of integers with a fixed bit width in MSB
+    ///        first order.
+    ///
+    /// The result is the same as calling \ref read_int for every value.
+    /// If the stream is byte aligned, the values are unpacked from blocks
+    /// of bytes read with \ref read_bytes. For widths of 8, 16 or 32 bits,
+    /// values of 32-bit types are unpacked with SSSE3 byte shuffles where
+    /// available.
+    ///
+    /// \tparam The integer type to read.
+    /// \param out Pointer to the first value to write to.
+    /// \param n The amount of integers to read.
+    /// \param amount The bit width of each integer.
+    /// \param offset A value added to each integer after reading it.
+    template<class T>
+    inline void read_ints(T* out, size_t n, size_t amount, T offset = T(0)) {
+        size_t i = 0;
+        if(m_cursor == 7 && amount > 0 && amount <= 57) {
+            // the values that fill whole bytes, so that the stream stays
+            // byte aligned for the remaining ones
+            const size_t group = 8U >> std::min(size_t(__builtin_ctzll(amount)), size_t(3));
+            const size_t m = n - n % group;
+
+            static constexpr size_t BUF_SIZE = 4096;
+            uint8_t buf[BUF_SIZE];
+
+            const uint64_t mask = (1ULL << amount) - 1ULL;
+            uint64_t acc = 0;
+            size_t fill = 0;
+
+            size_t bytes = m * amount / 8;
+            while(bytes > 0) {
+                const size_t len = std::min(bytes, BUF_SIZE);
+                read_bytes(buf, len);
+                bytes -= len;
+
+                size_t j = 0;
+#ifdef __SSSE3__
+                if(sizeof(T) == 4 && (amount == 8 || amount == 16 || amount == 32)) {
+                    // byte aligned widths: widen the big endian values to
+                    // 32 bits in one shuffle per four values
+                    const __m128i shuffle = (amount == 8)
+                        ? _mm_setr_epi8(0, -1, -1, -1, 1, -1, -1, -1,
+                                        2, -1, -1, -1, 3, -1, -1, -1)
+                        : (amount == 16)
+                        ? _mm_setr_epi8(1, 0, -1, -1, 3, 2, -1, -1,
+                                        5, 4, -1, -1, 7, 6, -1, -1)
+                        : _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                        11, 10, 9, 8, 15, 14, 13, 12);
+                    const __m128i off = _mm_set1_epi32(int32_t(offset));
+                    const size_t step = amount / 2; // bytes per four values
+
+                    // BUF_SIZE is a multiple of step, so no value is split
+                    // across blocks; the load may not exceed the buffer
+                    for(; j + 16 <= len; j += step, i += 4) {
+                        __m128i x = _mm_loadu_si128((const __m128i*)(buf + j));
+                        x = _mm_add_epi32(_mm_shuffle_epi8(x, shuffle), off);
+                        _mm_storeu_si128((__m128i*)(out + i), x);
+                    }
+                }
+#endif
+                for(; j < len; ++j) {
+                    acc = (acc << 8) | buf[j];
+                    fill += 8;
+
+                    while(fill >= amount) {
+                        fill -= amount;
+                        out[i++] = T(T((acc >> fill) & mask) + offset);
+                    }
+                }
+            }
+            DCHECK_EQ(i, m);
+        }
+
+        for(; i < n; ++i) {
+            out[i] = T(read_int<T>(amount) + offset);
         }
-        return value;
     }
 
     template<typename value_t>
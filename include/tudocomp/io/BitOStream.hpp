@@ -3,9 +3,14 @@
 #include <climits>
 #include <cstdint>
 #include <iostream>
+#include <type_traits>
 #include <tudocomp/util.hpp>
 #include <tudocomp/io/Output.hpp>
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 namespace tdc {
 namespace io {
 
@@ -29,6 +34,18 @@ class BitOStream {
         m_dirty = false;
     }
 
+    /// Converts a value to an unsigned 64-bit integer without sign
+    /// extension, so that only the bits of type \c T may be set.
+    template<class T>
+    static inline uint64_t to_bits(T value) {
+        typedef typename std::conditional<
+            std::is_integral<T>::value && std::is_signed<T>::value,
+            std::make_unsigned<T>,
+            std::enable_if<true, T>>::type::type unsigned_t;
+
+        return uint64_t(unsigned_t(value));
+    }
+
     inline void write_next() {
         if (m_dirty) {
             m_stream.put(char(m_next));
@@ -96,8 +113,132 @@ public:
     ///             this equals the bit width of type \c T.
     template<class T>
     inline void write_int(T value, size_t bits = sizeof(T) * CHAR_BIT) {
-        for (int i = bits - 1; i >= 0; i--) {
-            write_bit((value & T(T(1) << i)) != T(0));
+        const uint64_t u = to_bits(value);
+
+        // bits exceeding the width of a 64-bit integer are zero
+        for(; bits > 64; --bits) write_bit(0);
+
+        // fill the buffer byte chunk-wise instead of bit by bit
+        while(bits > 0) {
+            const size_t free = m_cursor + 1;
+            const size_t take = std::min(free, bits);
+            bits -= take;
+
+            const uint64_t chunk = (u >> bits) & ((1ULL << take) - 1ULL);
+            m_next |= uint8_t(chunk << (free - take));
+            m_cursor -= int(take);
+
+            m_dirty = true;
+            if(m_cursor < 0) {
+                write_next();
+            }
+        }
+    }
+
+    /// \brief Writes a sequence of integers with a fixed bit width in MSB
+    ///        first order to the output.
+    ///
+    /// The result is the same as calling \ref write_int for every value,
+    /// but the values are packed into a 64-bit word buffer and handed to the
+    /// underlying stream in blocks. If the stream is byte aligned and the
+    /// width is 8, 16 or 32 bits, values of 32-bit types are packed with
+    /// SSSE3 byte shuffles where available.
+    ///
+    /// \tparam T The type of integers to write.
+    /// \param values Pointer to the first value.
+    /// \param n The amount of values to write.
+    /// \param bits The amount of low bits of each value to write.
+    /// \param offset A value subtracted from each value before writing it.
+    template<class T>
+    inline void write_ints(const T* values, size_t n, size_t bits,
+                           T offset = T(0)) {
+
+        if(bits == 0 || n == 0) return;
+        if(bits > 57) {
+            // the accumulator cannot hold another value, fall back
+            for(size_t i = 0; i < n; ++i) write_int(T(values[i] - offset), bits);
+            return;
+        }
+
+        static constexpr size_t BUF_SIZE = 4096;
+        char buf[BUF_SIZE + 16];
+        size_t buf_len = 0;
+
+        // take over the bits of the pending buffer byte
+        size_t fill = 7 - m_cursor;
+        uint64_t acc = uint64_t(m_next) >> (m_cursor + 1);
+        const uint64_t mask = (1ULL << bits) - 1ULL;
+
+        size_t i = 0;
+#ifdef __SSSE3__
+        if(fill == 0 && sizeof(T) == 4 && (bits == 8 || bits == 16 || bits == 32)) {
+            // byte aligned widths: narrow to the lowest bytes and
+            // convert to big endian in one shuffle per four values
+            const __m128i shuffle = (bits == 8)
+                ? _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+                                -1, -1, -1, -1, -1, -1, -1, -1)
+                : (bits == 16)
+                ? _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12,
+                                -1, -1, -1, -1, -1, -1, -1, -1)
+                : _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                11, 10, 9, 8, 15, 14, 13, 12);
+            const __m128i off = _mm_set1_epi32(int32_t(offset));
+            const size_t step = bits / 2; // bytes per four values
+
+            for(; i + 4 <= n; i += 4) {
+                __m128i x = _mm_loadu_si128((const __m128i*)(values + i));
+                x = _mm_shuffle_epi8(_mm_sub_epi32(x, off), shuffle);
+                _mm_storeu_si128((__m128i*)(buf + buf_len), x);
+                buf_len += step;
+
+                if(buf_len >= BUF_SIZE) {
+                    m_stream.write(buf, buf_len);
+                    buf_len = 0;
+                }
+            }
+        }
+#endif
+        for(; i < n; ++i) {
+            acc = (acc << bits) | (to_bits(T(values[i] - offset)) & mask);
+            fill += bits;
+
+            while(fill >= 8) {
+                fill -= 8;
+                buf[buf_len++] = char(acc >> fill);
+            }
+
+            if(buf_len >= BUF_SIZE) {
+                m_stream.write(buf, buf_len);
+                buf_len = 0;
+            }
+        }
+
+        if(buf_len > 0) {
+            m_stream.write(buf, buf_len);
+        }
+
+        // keep the remaining bits in the buffer byte
+        reset();
+        if(fill > 0) {
+            m_next = uint8_t((acc & ((1ULL << fill) - 1ULL)) << (8 - fill));
+            m_cursor = 7 - int(fill);
+            m_dirty = true;
+        }
+    }
+
+    /// \brief Writes a sequence of bytes to the output.
+    ///
+    /// The result is the same as calling \ref write_int with a width of
+    /// eight bits for every byte. If the stream is byte aligned, the bytes
+    /// are handed to the underlying stream in one block.
+    ///
+    /// \param values Pointer to the first byte.
+    /// \param n The amount of bytes to write.
+    inline void write_bytes(const uint8_t* values, size_t n) {
+        if(m_cursor == 7) {
+            m_stream.write((const char*) values, n);
+        } else {
+            write_ints(values, n, 8);
         }
     }
 
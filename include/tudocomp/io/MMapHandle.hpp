@@ -10,6 +10,7 @@
 #include <tudocomp/def.hpp>
 #include <tudocomp/util/View.hpp>
 #include <tudocomp/io/IOUtil.hpp>
+#include <tudocomp/util/external.hpp>
 
 namespace tdc {namespace io {
     /// \cond INTERNAL
@@ -29,7 +30,8 @@ namespace tdc {namespace io {
         enum class State {
             Unmapped,
             Shared,
-            Private
+            Private,
+            Scratch
         };
 
         inline static size_t adj_size(size_t v) {
@@ -199,6 +201,64 @@ namespace tdc {namespace io {
             })
         }
 
+        /// Create an anonymous memory map of length `size` that the
+        /// kernel is advised to back with transparent huge pages.
+        inline static MMap huge_pages(size_t size) {
+            MMap m(size);
+#ifdef MADV_HUGEPAGE
+            // only a hint, failure is no error
+            madvise(m.m_ptr, adj_size(m.m_size), MADV_HUGEPAGE);
+#endif
+            return m;
+        }
+
+        /// Create a memory map of length `size` backed by a new file in
+        /// the directory `dir`, created as an \ref external::TempFile.
+        ///
+        /// The file is removed right away, and its contents are discarded
+        /// when the map is destroyed. The map is shared, so that its pages
+        /// can be paged out to the file instead of the swap space. Like for
+        /// any shared file map, the operating system writes modified pages
+        /// back to the file periodically, not only when memory gets scarce.
+        /// Unlike anonymous maps, the map is not counted as allocated
+        /// memory by the statistics tracking.
+        ///
+        /// Throws a `std::runtime_error` if the file cannot be created or
+        /// mapped.
+        inline static MMap scratch(const std::string& dir, size_t size) {
+            void* ptr;
+            {
+                external::TempFile file(dir);
+                const int fd = open(file.path().c_str(), O_RDWR);
+                if(fd == -1 || ftruncate(fd, adj_size(size)) != 0) {
+                    if(fd != -1) close(fd);
+                    throw std::runtime_error(
+                        "cannot resize scratch file " + file.path() +
+                        ": " + strerror(errno));
+                }
+
+                ptr = mmap(NULL,
+                           adj_size(size),
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED,
+                           fd,
+                           0);
+                close(fd);
+                if(ptr == MAP_FAILED) {
+                    throw std::runtime_error(
+                        "cannot map scratch file " + file.path() +
+                        ": " + strerror(errno));
+                }
+            }
+
+            MMap m;
+            m.m_ptr = (uint8_t*) ptr;
+            m.m_size = size;
+            m.m_mode = Mode::ReadWrite;
+            m.m_state = State::Scratch;
+            return m;
+        }
+
         /// Changes the size of this mapping.
         ///
         /// Only works if the mapping is in read-write mode.
@@ -226,7 +286,7 @@ namespace tdc {namespace io {
         GenericView<uint8_t> view() {
             const auto err = "Attempting to get a mutable view into a read-only mapping. Call the const overload of view() instead"_v;
 
-            DCHECK(m_state == State::Private) << err;
+            DCHECK(m_state == State::Private || m_state == State::Scratch) << err;
             DCHECK(m_mode == Mode::ReadWrite) << err;
             return GenericView<uint8_t>(m_ptr, m_size);
         }
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace tdc {
+
+/// \brief Allocation policies for data structures.
+///
+/// A policy provides typed `allocate`, `reallocate` and `deallocate`
+/// functions for types that can be copied bytewise, such as integers and
+/// \ref uint_t, as well as `release`, which frees everything allocated
+/// through the policy at once. Data structures take a policy as a template
+/// parameter or own an instance of one, so their memory is released in bulk
+/// when they are destroyed, e.g., at the end of a phase.
+///
+/// \ref Heap passes each call on to the heap, \ref Arena hands out memory
+/// from large chunks and \ref Pool additionally reuses freed memory by size
+/// classes. The chunks are taken from the heap, so they are seen by the
+/// statistics tracking like other allocations.
+namespace alloc {
+
+/// \cond INTERNAL
+template<typename policy_t>
+class AllocatorBase {
+    inline policy_t& self() { return static_cast<policy_t&>(*this); }
+
+public:
+    /// \brief Allocates uninitialized memory for \c n values.
+    template<typename T>
+    inline T* allocate(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value,
+            "only trivially destructible types are supported");
+        return (T*) self().allocate_bytes(n * sizeof(T), alignof(T));
+    }
+
+    /// \brief Resizes memory holding \c n_old values to hold \c n values.
+    ///
+    /// The first `min(n_old, n)` values are preserved. The memory may be
+    /// moved.
+    template<typename T>
+    inline T* reallocate(T* p, size_t n_old, size_t n) {
+        return (T*) self().reallocate_bytes(
+            p, n_old * sizeof(T), n * sizeof(T), alignof(T));
+    }
+
+    /// \brief Frees memory holding \c n values.
+    template<typename T>
+    inline void deallocate(T* p, size_t n) {
+        self().deallocate_bytes(p, n * sizeof(T));
+    }
+};
+/// \endcond
+
+/// \brief Allocates each request on the heap.
+///
+/// Memory is not freed in bulk, \ref release does nothing.
+class Heap: public AllocatorBase<Heap> {
+public:
+    inline void* allocate_bytes(size_t bytes, size_t) {
+        void* p = std::malloc(std::max(bytes, size_t(1)));
+        if(!p) throw std::bad_alloc();
+        return p;
+    }
+
+    inline void* reallocate_bytes(void* p, size_t, size_t bytes, size_t) {
+        void* q = std::realloc(p, std::max(bytes, size_t(1)));
+        if(!q) throw std::bad_alloc();
+        return q;
+    }
+
+    inline void deallocate_bytes(void* p, size_t) {
+        std::free(p);
+    }
+
+    inline void release() {
+    }
+};
+
+/// \brief Hands out memory from chunks of increasing size.
+///
+/// Allocating advances a pointer in the current chunk and freeing does
+/// nothing, except for the most recent allocation, which can also be
+/// resized in place. All chunks are freed by \ref release or when the
+/// arena is destroyed.
+class Arena: public AllocatorBase<Arena> {
+public:
+    /// \brief The alignment of all allocations.
+    static constexpr size_t ALIGN = 8;
+
+    /// \brief The size of the first chunk in bytes.
+    static constexpr size_t MIN_CHUNK = size_t(64) << 10;
+
+    /// \brief The size of chunks in bytes after which they stop growing.
+    static constexpr size_t MAX_CHUNK = size_t(16) << 20;
+
+private:
+    std::vector<void*> m_chunks;
+    uint8_t* m_pos = nullptr;
+    uint8_t* m_end = nullptr;
+    uint8_t* m_last = nullptr;
+    size_t m_next_chunk = MIN_CHUNK;
+    size_t m_capacity = 0;
+
+    inline static size_t round(size_t bytes) {
+        return (std::max(bytes, size_t(1)) + ALIGN - 1) & ~(ALIGN - 1);
+    }
+
+    inline void grow(size_t bytes) {
+        const size_t size = std::max(m_next_chunk, bytes);
+        void* chunk = std::malloc(size);
+        if(!chunk) throw std::bad_alloc();
+
+        m_chunks.push_back(chunk);
+        m_pos = (uint8_t*) chunk;
+        m_end = m_pos + size;
+        m_last = nullptr;
+        m_next_chunk = std::min(2 * m_next_chunk, size_t(MAX_CHUNK));
+        m_capacity += size;
+    }
+
+public:
+    inline Arena() = default;
+    inline Arena(const Arena&) = delete;
+    inline Arena& operator=(const Arena&) = delete;
+
+    inline Arena(Arena&& other):
+        m_chunks(std::move(other.m_chunks)),
+        m_pos(other.m_pos), m_end(other.m_end), m_last(other.m_last),
+        m_next_chunk(other.m_next_chunk), m_capacity(other.m_capacity) {
+
+        other.m_chunks.clear();
+        other.m_pos = other.m_end = other.m_last = nullptr;
+        other.m_next_chunk = MIN_CHUNK;
+        other.m_capacity = 0;
+    }
+
+    inline Arena& operator=(Arena&& other) {
+        if(this != &other) {
+            release();
+            std::swap(m_chunks, other.m_chunks);
+            std::swap(m_pos, other.m_pos);
+            std::swap(m_end, other.m_end);
+            std::swap(m_last, other.m_last);
+            std::swap(m_next_chunk, other.m_next_chunk);
+            std::swap(m_capacity, other.m_capacity);
+        }
+        return *this;
+    }
+
+    inline ~Arena() {
+        release();
+    }
+
+    inline void* allocate_bytes(size_t bytes, size_t align = ALIGN) {
+        DCHECK_LE(align, ALIGN);
+        bytes = round(bytes);
+        if(size_t(m_end - m_pos) < bytes) grow(bytes);
+
+        m_last = m_pos;
+        m_pos += bytes;
+        return m_last;
+    }
+
+    inline void* reallocate_bytes(void* p, size_t old_bytes, size_t bytes,
+                                  size_t align = ALIGN) {
+
+        if(p != nullptr && p == m_last &&
+           size_t(m_end - m_last) >= round(bytes)) {
+            // the most recent allocation is resized in place
+            m_pos = m_last + round(bytes);
+            return p;
+        }
+
+        void* q = allocate_bytes(bytes, align);
+        if(p != nullptr) std::memcpy(q, p, std::min(old_bytes, bytes));
+        return q;
+    }
+
+    inline void deallocate_bytes(void* p, size_t) {
+        if(p != nullptr && p == m_last) {
+            m_pos = m_last;
+            m_last = nullptr;
+        }
+    }
+
+    /// \brief Frees all chunks.
+    inline void release() {
+        for(void* chunk : m_chunks) std::free(chunk);
+        m_chunks.clear();
+        m_pos = m_end = m_last = nullptr;
+        m_next_chunk = MIN_CHUNK;
+        m_capacity = 0;
+    }
+
+    /// \brief Yields the total size of all chunks in bytes.
+    inline size_t capacity() const {
+        return m_capacity;
+    }
+};
+
+/// \brief Reuses freed memory by size classes, on top of an \ref Arena.
+///
+/// Sizes up to \ref SMALL bytes are rounded up to multiples of 16 bytes,
+/// larger ones to powers of two. Freed memory is kept in a list for its
+/// size class and handed out again by later allocations of that class.
+/// Resizing within a size class does not move the memory, so a sequence
+/// of growing an array by single values moves it only a few times.
+class Pool: public AllocatorBase<Pool> {
+public:
+    /// \brief The size in bytes up to which classes are 16 bytes apart.
+    static constexpr size_t SMALL = 256;
+
+private:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t NUM_SMALL = SMALL / GRANULARITY;
+
+    Arena m_arena;
+    std::vector<void*> m_free; // heads of the free lists by class
+
+    inline static size_t size_class(size_t bytes) {
+        if(bytes <= SMALL) {
+            return (std::max(bytes, size_t(1)) + GRANULARITY - 1) / GRANULARITY - 1;
+        } else {
+            // SMALL is a power of two, the next class is 2 * SMALL
+            const size_t lg = 64 - __builtin_clzll(bytes - 1);
+            return NUM_SMALL + lg - (__builtin_ctzll(SMALL) + 1);
+        }
+    }
+
+    inline static size_t class_size(size_t c) {
+        return (c < NUM_SMALL)
+            ? (c + 1) * GRANULARITY
+            : SMALL << (c - NUM_SMALL + 1);
+    }
+
+public:
+    inline Pool() = default;
+    inline Pool(Pool&&) = default;
+    inline Pool& operator=(Pool&&) = default;
+
+    inline void* allocate_bytes(size_t bytes, size_t align = Arena::ALIGN) {
+        DCHECK_LE(align, Arena::ALIGN);
+        const size_t c = size_class(bytes);
+        if(c < m_free.size() && m_free[c] != nullptr) {
+            void* p = m_free[c];
+            std::memcpy(&m_free[c], p, sizeof(void*));
+            return p;
+        }
+        return m_arena.allocate_bytes(class_size(c));
+    }
+
+    inline void* reallocate_bytes(void* p, size_t old_bytes, size_t bytes,
+                                  size_t align = Arena::ALIGN) {
+
+        if(p != nullptr && size_class(old_bytes) == size_class(bytes)) {
+            return p;
+        }
+
+        void* q = allocate_bytes(bytes, align);
+        if(p != nullptr) {
+            std::memcpy(q, p, std::min(old_bytes, bytes));
+            deallocate_bytes(p, old_bytes);
+        }
+        return q;
+    }
+
+    inline void deallocate_bytes(void* p, size_t bytes) {
+        if(p == nullptr) return;
+
+        const size_t c = size_class(bytes);
+        if(c >= m_free.size()) m_free.resize(c + 1, nullptr);
+        std::memcpy(p, &m_free[c], sizeof(void*));
+        m_free[c] = p;
+    }
+
+    /// \brief Frees all memory.
+    inline void release() {
+        m_free.clear();
+        m_arena.release();
+    }
+
+    /// \brief Yields the total size of the memory taken from the heap in
+    ///        bytes.
+    inline size_t capacity() const {
+        return m_arena.capacity();
+    }
+};
+
+}} //ns
@@ -3,6 +3,7 @@
 #include <tudocomp/Algorithm.hpp>
 #include <tudocomp/util.hpp>
 #include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/util/Allocator.hpp>
 #include <tudocomp_stat/StatPhase.hpp>
 // #include <tudocomp/util/hash/clhash.h>
 // #include <tudocomp/util/hash/zobrist.h>
@@ -357,7 +358,8 @@ template <class Key, class Value,
           class HashFcn = MixHasher,
           class EqualKey = std::equal_to<Key>,
 		  class ProbeFcn = QuadraticProber,
-		  class SizeManager = SizeManagerPow2
+		  class SizeManager = SizeManagerPow2,
+		  class Allocator = alloc::Heap
           >
 class HashMap {
 	//static_assert(!std::is_same<ProbeFcn, QuadraticProber>::value || !std::is_same<SizeManager,SizeManagerPow2>::value, "Cannot use QuadraticProber with SizeManagerPow2");
@@ -373,6 +375,7 @@ class HashMap {
 
 
 	EqualKey m_eq;
+	Allocator m_alloc;
 	HashFcn m_h;
 	ProbeFcn m_probe;
 	SizeManager m_sizeman;
@@ -383,6 +386,24 @@ class HashMap {
 	float m_load_factor = 0.3f;
 	static constexpr value_t empty_val = undef_id;
 	static constexpr len_t initial_size = 4; // nark::__hsm_stl_next_prime(1)
+
+	// keys and values share one allocation, the keys come first
+	inline static size_t keys_bytes(size_t size) {
+		return (sizeof(key_t)*size + alignof(value_t) - 1) & ~(alignof(value_t) - 1);
+	}
+	inline static size_t table_bytes(size_t size) {
+		return keys_bytes(size) + sizeof(value_t)*size;
+	}
+	inline void allocate_table(key_t*& keys, value_t*& values, size_t size) {
+		uint8_t* block = m_alloc.template allocate<uint8_t>(table_bytes(size));
+		keys = (key_t*) block;
+		values = (value_t*) (block + keys_bytes(size));
+		for(size_t i = 0; i < size; ++i) values[i] = undef_id;
+	}
+	inline void free_table(key_t* keys, size_t size) {
+		if(keys != nullptr) m_alloc.deallocate((uint8_t*) keys, table_bytes(size));
+	}
+
 	IF_STATS(
 		size_t m_collisions = 0;
 		size_t m_old_size = 0;
@@ -418,20 +439,19 @@ class HashMap {
 // env.env_for_option("hash_prober"))
 		, m_sizeman(create_env(SizeManager::meta())) //env.env_for_option("hash_manager"))
 		, m_size(initial_size)
-		, m_keys(new key_t[initial_size])
-		, m_values(new value_t[initial_size])
 		, m_n(n)
 		, m_remaining_characters(remaining_characters)
 	{
-		for(size_t i = 0; i < m_size; ++i) m_values[i] = undef_id;
+		allocate_table(m_keys, m_values, m_size);
 		m_sizeman.resize(m_size);
 	}
 	template<class T>
 	void incorporate(T&& o, len_t newsize)
 	{
-		if(m_keys != nullptr) { delete [] m_keys; }
-		if(m_values != nullptr) { delete [] m_values; }
+		free_table(m_keys, m_size);
 
+		// the table is taken over along with the memory it was allocated from
+		m_alloc = std::move(o.m_alloc);
 		m_keys = std::move(o.m_keys);
 		m_values = std::move(o.m_values);
 		m_size = std::move(o.m_size);
@@ -451,8 +471,7 @@ class HashMap {
 	MoveGuard m_guard;
 	~HashMap() {
         if (m_guard) {
-            if(m_keys != nullptr) { delete [] m_keys; }
-            if(m_values != nullptr) { delete [] m_values; }
+            free_table(m_keys, m_size);
         }
 	}
 	inline HashMap(HashMap&& other) = default;
@@ -465,12 +484,9 @@ class HashMap {
 			const size_t oldsize = m_size;
 			m_size = size;
 			m_sizeman.resize(m_size);
-			// key_t* keys = new key_t[m_size];
-			// value_t* values = new value_t[m_size];
-			key_t* keys = (key_t*) malloc(sizeof(key_t)*m_size);
-			value_t* values = (value_t*) malloc(sizeof(value_t)*m_size);
-			for(size_t i = 0; i < m_size; ++i) values[i] = undef_id;
-//			memset(values, 0, sizeof(value_t)*size);
+			key_t* keys;
+			value_t* values;
+			allocate_table(keys, values, m_size);
 			std::swap(m_values,values);
 			std::swap(m_keys,keys);
 			m_entries=0;
@@ -479,16 +495,13 @@ class HashMap {
 				auto ret = insert(std::make_pair(std::move(keys[i]),std::move(values[i])));
 				DCHECK_EQ(ret.second, true); // no duplicates
 			}
-			delete [] keys;
-			delete [] values;
+			free_table(keys, oldsize);
 		}
 		else {
+			free_table(m_keys, m_size);
 			m_size = size;
 			m_sizeman.resize(m_size);
-			m_values = (value_t*) realloc(m_values, sizeof(value_t) * m_size);
-			//memset(m_values, 0, sizeof(value_t)*size);
-			for(size_t i = 0; i < m_size; ++i) m_values[i] = undef_id;
-			m_keys = (key_t*) realloc(m_keys, sizeof(key_t) * m_size);
+			allocate_table(m_keys, m_values, m_size);
 		}
 	}
 
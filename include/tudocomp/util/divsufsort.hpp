@@ -225,6 +225,83 @@ inline void construct_SA(
   }
 }
 
+// from divsufsort.c
+/* Constructs the burrows-wheeler transformed string directly
+   by using the sorted order of type B* suffixes.
+   sample(s, i) is called with the final position i of each suffix s > 0. */
+template<typename buffer_t, typename sample_t>
+inline saidx_t construct_BWT(
+        const sauchar_t *T, buffer_t& SA,
+              saidx_t *bucket_A, saidx_t *bucket_B,
+              saidx_t n, saidx_t m, sample_t sample) {
+
+  saidx_t i, j, k, orig;
+  saidx_t s;
+  saint_t c0, c1, c2;
+
+  if(0 < m) {
+    /* Construct the sorted order of type B suffixes by using
+       the sorted order of type B* suffixes. */
+    for(c1 = ALPHABET_SIZE - 2; 0 <= c1; --c1) {
+      /* Scan the suffix array from right to left. */
+      for(i = BUCKET_BSTAR(c1, c1 + 1),
+          j = BUCKET_A(c1 + 1) - 1, k = -1, c2 = -1;
+          i <= j;
+          --j) {
+        if(0 < (s = SA[j])) {
+          assert(T[s] == c1);
+          assert(((s + 1) < n) && (T[s] <= T[s + 1]));
+          assert(T[s - 1] <= T[s]);
+          sample(s, j);
+          c0 = T[--s];
+          SA[j] = ~((saidx_t)c0);
+          if((0 < s) && (T[s - 1] > c0)) { s = ~s; }
+          if(c0 != c2) {
+            if(0 <= c2) { BUCKET_B(c2, c1) = k; }
+
+            k = BUCKET_B(c2 = c0, c1);
+          }
+          assert(k < j);
+          SA[k--] = s;
+        } else if(s != 0) {
+          sample(~s, j);
+          SA[j] = ~s;
+        } else {
+          assert(T[s] == c1);
+        }
+      }
+    }
+  }
+
+  /* Construct the BWTed string by using
+     the sorted order of type B suffixes. */
+  k = BUCKET_A(c2 = T[n - 1]);
+  sample(n - 1, k);
+  SA[k++] = (T[n - 2] < c2) ? ~((saidx_t)T[n - 2]) : (n - 1);
+  /* Scan the suffix array from left to right. */
+  for(i = 0, j = n, orig = 0; i < j; ++i) {
+    if(0 < (s = SA[i])) {
+      assert(T[s - 1] >= T[s]);
+      c0 = T[--s];
+      SA[i] = c0;
+      if(c0 != c2) {
+        BUCKET_A(c2) = k;
+        k = BUCKET_A(c2 = c0);
+      }
+      assert(i < k);
+      if(0 < s) { sample(s, k); }
+      if((0 < s) && (T[s - 1] < c0)) { s = ~((saidx_t)T[s - 1]); }
+      SA[k++] = s;
+    } else if(s != 0) {
+      SA[i] = ~s;
+    } else {
+      orig = i;
+    }
+  }
+
+  return orig;
+}
+
 // the actual divsufsort execution
 template<typename buffer_t>
 inline void divsufsort_run(
@@ -287,9 +364,61 @@ inline saint_t divsufsort(const sauchar_t* T, buffer_t& SA, saidx_t n) {
   return err;
 }
 
+/// \brief Constructs the BWT of a text without its suffix array.
+///
+/// Unlike the original divbwt, the BWT is left in the work buffer B, one
+/// character per entry, with B[i] = T[SA[i] - 1] and B[i] = T[n - 1] where
+/// SA[i] = 0. The buffer needs to hold n signed integers.
+///
+/// The position i of each suffix s > 0, i.e., SA[i] = s, is reported by
+/// calling sample(s, i). This way, samples of the inverse suffix array are
+/// obtained without the suffix array.
+///
+/// \return The position i where SA[i] = 0, or a negative value on error.
+template<typename buffer_t, typename sample_t>
+inline saidx_t divbwt(const sauchar_t* T, buffer_t& B, saidx_t n, sample_t sample) {
+  saidx_t *bucket_A, *bucket_B;
+  saidx_t m, pidx;
+
+  /* Check arguments. */
+  if((T == NULL) || (n < 0)) { return -1; }
+  else if(n == 0) { return 0; }
+  else if(n == 1) { B[0] = T[0]; return 0; }
+  else if(n == 2) {
+    m = (T[0] < T[1]);
+    B[m ^ 1] = T[1], B[m] = T[0];
+    sample(1, m);
+    return m ^ 1;
+  }
+
+  bucket_A = new saidx_t[BUCKET_A_SIZE];
+  bucket_B = new saidx_t[BUCKET_B_SIZE];
+
+  /* Burrows-Wheeler Transform. */
+  if((bucket_A != NULL) && (bucket_B != NULL)) {
+    m = sort_typeBstar(T, B, bucket_A, bucket_B, n);
+    pidx = construct_BWT(T, B, bucket_A, bucket_B, n, m, sample);
+    B[pidx] = T[n - 1];
+  } else {
+    pidx = -2;
+  }
+
+  delete[] bucket_B;
+  delete[] bucket_A;
+
+  return pidx;
+}
+
+/// \brief Constructs the BWT of a text without its suffix array.
+template<typename buffer_t>
+inline saidx_t divbwt(const sauchar_t* T, buffer_t& B, saidx_t n) {
+  return divbwt(T, B, n, [](saidx_t, saidx_t){});
+}
+
 } //ns divsufsort
 
 using libdivsufsort::saidx_t;
 using libdivsufsort::divsufsort;
+using libdivsufsort::divbwt;
 
 } //ns tdc
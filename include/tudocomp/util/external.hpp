@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <glog/logging.h>
+
+namespace tdc {
+namespace external {
+
+/// \brief A file in a scratch directory that is removed on destruction.
+class TempFile {
+private:
+    std::string m_path;
+
+public:
+    /// \brief Creates a new, empty file with a unique name.
+    /// \param dir The scratch directory.
+    inline TempFile(const std::string& dir) {
+        std::string name = dir + "/tudocomp_XXXXXX";
+        std::vector<char> buf(name.begin(), name.end());
+        buf.push_back(0);
+
+        const int fd = mkstemp(buf.data());
+        if(fd == -1) {
+            throw std::runtime_error(
+                "cannot create scratch file in " + dir + ": " + strerror(errno));
+        }
+        close(fd);
+        m_path = buf.data();
+    }
+
+    inline TempFile(TempFile&& other) : m_path(std::move(other.m_path)) {
+        other.m_path.clear();
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    inline ~TempFile() {
+        if(!m_path.empty()) unlink(m_path.c_str());
+    }
+
+    /// \brief Yields the file's path.
+    inline const std::string& path() const {
+        return m_path;
+    }
+};
+
+/// \cond INTERNAL
+inline FILE* open_file(const std::string& path, const char* mode) {
+    FILE* f = fopen(path.c_str(), mode);
+    if(!f) {
+        throw std::runtime_error(
+            "cannot open scratch file " + path + ": " + strerror(errno));
+    }
+    return f;
+}
+/// \endcond
+
+/// \brief Writes a sequence of trivially copyable items to a file through
+///        a buffer.
+template<typename T>
+class Writer {
+private:
+    FILE* m_file;
+    std::vector<T> m_buffer;
+    size_t m_fill = 0;
+    size_t m_count = 0;
+
+    inline void flush() {
+        if(m_fill > 0 && fwrite(m_buffer.data(), sizeof(T), m_fill, m_file) != m_fill) {
+            throw std::runtime_error("cannot write scratch file");
+        }
+        m_fill = 0;
+    }
+
+public:
+    /// \brief Constructor.
+    /// \param path The file to write, its contents are replaced.
+    /// \param buffer_size The amount of items to buffer.
+    inline Writer(const std::string& path, size_t buffer_size)
+        : m_file(open_file(path, "wb")),
+          m_buffer(std::max(buffer_size, size_t(1))) {
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    inline ~Writer() {
+        close();
+    }
+
+    /// \brief Appends an item.
+    inline void push(const T& x) {
+        m_buffer[m_fill++] = x;
+        ++m_count;
+        if(m_fill == m_buffer.size()) flush();
+    }
+
+    /// \brief Writes all buffered items and closes the file.
+    inline void close() {
+        if(m_file) {
+            flush();
+            fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    /// \brief Yields the amount of items written.
+    inline size_t size() const {
+        return m_count;
+    }
+};
+
+/// \brief Reads a sequence of trivially copyable items from a file through
+///        a buffer.
+template<typename T>
+class Reader {
+private:
+    FILE* m_file;
+    std::vector<T> m_buffer;
+    size_t m_pos = 0;
+    size_t m_fill = 0;
+
+    inline void fill() {
+        m_pos = 0;
+        m_fill = fread(m_buffer.data(), sizeof(T), m_buffer.size(), m_file);
+    }
+
+public:
+    /// \brief Constructor.
+    /// \param path The file to read.
+    /// \param buffer_size The amount of items to buffer.
+    inline Reader(const std::string& path, size_t buffer_size)
+        : m_file(open_file(path, "rb")),
+          m_buffer(std::max(buffer_size, size_t(1))) {
+        fill();
+    }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    inline ~Reader() {
+        fclose(m_file);
+    }
+
+    /// \brief Tests whether there are more items.
+    inline bool has_next() const {
+        return m_pos < m_fill;
+    }
+
+    /// \brief Yields the next item without consuming it.
+    inline const T& peek() const {
+        DCHECK(has_next());
+        return m_buffer[m_pos];
+    }
+
+    /// \brief Consumes the next item.
+    inline T next() {
+        const T x = peek();
+        if(++m_pos == m_fill) fill();
+        return x;
+    }
+};
+
+/// \brief Sorts a sequence of items that may not fit into memory.
+///
+/// Items are collected in memory up to a given budget. Full buffers are
+/// sorted and written to scratch files as runs, which are merged when the
+/// sorted sequence is requested. The buffers used to grow, write and merge
+/// the runs together stay within the budget.
+template<typename T, typename comp_t>
+class Sorter {
+private:
+    std::string m_dir;
+    size_t m_memory;
+    size_t m_limit;
+    size_t m_io; // the amount of items buffered when writing a run
+    comp_t m_comp;
+
+    std::vector<T> m_buffer;
+    std::vector<std::unique_ptr<TempFile>> m_runs;
+
+    inline void write_run() {
+        std::sort(m_buffer.begin(), m_buffer.end(), m_comp);
+
+        m_runs.emplace_back(new TempFile(m_dir));
+        {
+            Writer<T> w(m_runs.back()->path(), m_io);
+            for(auto& x : m_buffer) w.push(x);
+        }
+        m_buffer.clear();
+    }
+
+public:
+    /// \brief Constructor.
+    /// \param dir The scratch directory for runs.
+    /// \param memory The memory budget in bytes.
+    /// \param comp The comparison of items.
+    inline Sorter(const std::string& dir, size_t memory, comp_t comp = comp_t())
+        : m_dir(dir),
+          m_memory(std::max(memory, sizeof(T) * 16)),
+          m_limit(m_memory / sizeof(T)),
+          m_io(m_limit / 16),
+          m_comp(comp) {
+    }
+
+    /// \brief Adds an item.
+    inline void push(const T& x) {
+        if(m_buffer.size() == m_buffer.capacity()) {
+            // grow, but the old and the new buffer have to fit into the
+            // memory budget next to the buffer for writing the run
+            const size_t c = m_buffer.capacity();
+            const size_t grown = std::min(std::max(2 * c, size_t(16)),
+                                          m_limit - m_io - c);
+            if(grown > c) {
+                m_buffer.reserve(grown);
+            } else {
+                write_run();
+            }
+        }
+        m_buffer.push_back(x);
+    }
+
+    /// \brief Yields the amount of runs written to scratch files.
+    inline size_t runs() const {
+        return m_runs.size();
+    }
+
+    /// \brief Calls `f(item)` for all items in sorted order and clears the
+    ///        sorter.
+    template<typename F>
+    inline void sort(F f) {
+        if(m_runs.empty()) {
+            // everything fits into memory
+            std::sort(m_buffer.begin(), m_buffer.end(), m_comp);
+            for(auto& x : m_buffer) f(x);
+            std::vector<T>().swap(m_buffer);
+            return;
+        }
+
+        if(!m_buffer.empty()) write_run();
+        std::vector<T>().swap(m_buffer);
+
+        // merge runs
+        const size_t k = m_runs.size();
+        const size_t buffer_size = m_limit / k;
+
+        std::vector<std::unique_ptr<Reader<T>>> readers;
+        for(auto& run : m_runs) {
+            readers.emplace_back(new Reader<T>(run->path(), buffer_size));
+        }
+
+        auto greater = [&](size_t a, size_t b) {
+            return m_comp(readers[b]->peek(), readers[a]->peek());
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+        for(size_t i = 0; i < k; i++) {
+            if(readers[i]->has_next()) heap.push(i);
+        }
+
+        while(!heap.empty()) {
+            const size_t i = heap.top();
+            heap.pop();
+            f(readers[i]->next());
+            if(readers[i]->has_next()) heap.push(i);
+        }
+
+        readers.clear();
+        m_runs.clear();
+    }
+};
+
+/// \brief A read-only memory mapping of a file of trivially copyable items.
+///
+/// The mapped pages are backed by the file and not counted as allocated
+/// memory.
+template<typename T>
+class MappedArray {
+private:
+    const T* m_data = nullptr;
+    size_t m_size = 0;
+
+    inline void unmap() {
+        if(m_data && m_size > 0) munmap((void*) m_data, m_size * sizeof(T));
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+public:
+    inline MappedArray() {}
+
+    /// \brief Maps a file.
+    /// \param path The file to map. It may be removed after mapping.
+    /// \param n The amount of items in the file.
+    inline MappedArray(const std::string& path, size_t n) : m_size(n) {
+        if(n == 0) return;
+
+        FILE* f = open_file(path, "rb");
+        void* ptr = mmap(nullptr, n * sizeof(T), PROT_READ, MAP_SHARED, fileno(f), 0);
+        fclose(f);
+
+        if(ptr == MAP_FAILED) {
+            throw std::runtime_error(
+                "cannot map scratch file " + path + ": " + strerror(errno));
+        }
+        m_data = (const T*) ptr;
+    }
+
+    inline MappedArray(MappedArray&& other)
+        : m_data(other.m_data), m_size(other.m_size) {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    inline MappedArray& operator=(MappedArray&& other) {
+        unmap();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    inline ~MappedArray() {
+        unmap();
+    }
+
+    inline const T& operator[](size_t i) const {
+        DCHECK_LT(i, m_size);
+        return m_data[i];
+    }
+
+    inline const T* data() const {
+        return m_data;
+    }
+
+    inline size_t size() const {
+        return m_size;
+    }
+};
+
+}} //ns
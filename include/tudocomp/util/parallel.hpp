@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
+
+namespace tdc {
+namespace parallel {
+
+/// Yields the amount of threads to use for a requested amount.
+///
+/// A request of zero yields the amount of hardware threads.
+inline size_t num_threads(size_t requested) {
+    if(requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return std::max(requested, size_t(1));
+}
+
+/// Splits the range [0, n) into at most `threads` chunks and calls
+/// `f(thread_id, begin, end)` for each chunk in its own thread.
+///
+/// Chunk boundaries are multiples of `align`, so that threads writing to
+/// a bit packed vector never share a word if `align` is a multiple of 64.
+/// The first chunk is processed by the calling thread. Allocations of the
+/// other threads are attributed to the calling thread's current phase.
+/// Returns after all chunks have been processed.
+template<typename F>
+inline void for_chunks(size_t n, size_t threads, size_t align, F f) {
+    DCHECK_GT(align, 0U);
+
+    const size_t units = (n + align - 1) / align;
+    const size_t p = std::max(std::min(threads, units), size_t(1));
+    const size_t units_per_chunk = (units + p - 1) / std::max(p, size_t(1));
+
+    std::vector<std::thread> workers;
+    workers.reserve(p);
+
+    auto phase = StatPhase::current();
+    auto worker = [&f, phase](size_t t, size_t begin, size_t end) {
+        StatPhase::attach(phase);
+        f(t, begin, end);
+    };
+
+    for(size_t t = 1; t < p; t++) {
+        const size_t begin = std::min(t * units_per_chunk * align, n);
+        const size_t end = std::min((t + 1) * units_per_chunk * align, n);
+        if(begin < end) workers.emplace_back(worker, t, begin, end);
+    }
+    f(size_t(0), size_t(0), std::min(units_per_chunk * align, n));
+
+    for(auto& w : workers) w.join();
+}
+
+/// Sorts the range [first, last) using the given amount of threads.
+///
+/// The range is split into chunks that are sorted independently, which
+/// are then merged pairwise in parallel.
+template<typename iterator_t, typename compare_t>
+inline void sort(iterator_t first, iterator_t last, compare_t comp,
+                 size_t threads) {
+
+    const size_t n = std::distance(first, last);
+
+    // below this size, sorting is not worth starting threads
+    constexpr size_t MIN_CHUNK = 1ULL << 14;
+
+    const size_t p = std::min(threads, std::max(n / MIN_CHUNK, size_t(1)));
+    if(p <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds(p + 1);
+    for(size_t t = 0; t <= p; t++) bounds[t] = (n * t) / p;
+
+    for_chunks(p, p, 1, [&](size_t, size_t b, size_t e) {
+        for(size_t t = b; t < e; t++) {
+            std::sort(first + bounds[t], first + bounds[t + 1], comp);
+        }
+    });
+
+    for(size_t step = 1; step < p; step *= 2) {
+        const size_t merges = (p + 2 * step - 1) / (2 * step);
+        for_chunks(merges, merges, 1, [&](size_t, size_t b, size_t e) {
+            for(size_t m = b; m < e; m++) {
+                const size_t lo = 2 * step * m;
+                const size_t mid = std::min(lo + step, p);
+                const size_t hi = std::min(lo + 2 * step, p);
+                if(mid < hi) {
+                    std::inplace_merge(first + bounds[lo],
+                                       first + bounds[mid],
+                                       first + bounds[hi], comp);
+                }
+            }
+        });
+    }
+}
+
+/// Writes `out[dest(i)] = value(i)` for all i in [0, n) using the given
+/// amount of threads, where `dest` is a permutation of [0, n).
+///
+/// The destinations are split into sub-buckets of 2^15 destinations, which
+/// fit into the L2 cache. In passes over batches of the input, the pairs of
+/// destination and value are distributed to their buckets, which are then
+/// written by the threads one bucket at a time. To keep the distribution
+/// itself cache friendly, at most 2^12 buckets are used, so for n > 2^27
+/// a bucket consists of several consecutive sub-buckets. The thread writing
+/// such a bucket first distributes it to its sub-buckets, using the counts
+/// of the sub-buckets from the batch's counting pass, so that the writes to
+/// `out` stay within the L2 cache for any n. Bucket boundaries are
+/// multiples of 64, so `out` may be a bit packed vector.
+///
+/// Besides `out`, a buffer for one batch of `n / 8` pairs and a counter per
+/// sub-bucket and thread are allocated. For n > 2^27, each thread also
+/// allocates a buffer for one bucket.
+template<typename out_t, typename dest_t, typename value_t>
+inline void scatter(out_t& out, size_t n, dest_t dest, value_t value,
+                    size_t threads) {
+
+    // destinations per sub-bucket, and the maximum amount of buckets
+    constexpr size_t BUCKET_SIZE = 1ULL << 15;
+    constexpr size_t MAX_BUCKETS = 1ULL << 12;
+    constexpr size_t BATCHES = 8;
+
+    if(n <= BUCKET_SIZE) {
+        for(size_t i = 0; i < n; i++) out[dest(i)] = value(i);
+        return;
+    }
+
+    // each bucket consists of `subs` consecutive sub-buckets
+    const size_t fines = (n + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    const size_t subs = (fines + MAX_BUCKETS - 1) / MAX_BUCKETS;
+    const size_t buckets = (fines + subs - 1) / subs;
+    const size_t bucket_size = subs * BUCKET_SIZE;
+    const size_t batch = std::max((n + BATCHES - 1) / BATCHES, BUCKET_SIZE);
+
+    struct entry_t {
+        len_t dest, value;
+    };
+
+    std::vector<entry_t> buffer(batch);
+    std::vector<size_t> start(buckets + 1);
+    std::vector<size_t> fine_start(fines);
+    std::vector<std::vector<size_t>> count(threads, std::vector<size_t>(fines));
+    std::vector<std::vector<size_t>> offset(threads, std::vector<size_t>(buckets));
+
+    for(size_t first = 0; first < n; first += batch) {
+        const size_t m = std::min(batch, n - first);
+
+        // count the entries per sub-bucket and thread
+        for(auto& c : count) std::fill(c.begin(), c.end(), 0);
+        for_chunks(m, threads, 1, [&](size_t tid, size_t b, size_t e) {
+            auto& c = count[tid];
+            for(size_t i = first + b; i < first + e; i++) {
+                ++c[dest(i) / BUCKET_SIZE];
+            }
+        });
+
+        // turn counts into per-thread distribution offsets of the buckets
+        // and into the starts of the sub-buckets
+        size_t sum = 0;
+        for(size_t k = 0; k < buckets; k++) {
+            const size_t f_end = std::min((k + 1) * subs, fines);
+            start[k] = sum;
+            for(size_t tid = 0; tid < threads; tid++) {
+                offset[tid][k] = sum;
+                for(size_t f = k * subs; f < f_end; f++) sum += count[tid][f];
+            }
+        }
+        start[buckets] = sum;
+
+        sum = 0;
+        for(size_t f = 0; f < fines; f++) {
+            fine_start[f] = sum;
+            for(size_t tid = 0; tid < threads; tid++) sum += count[tid][f];
+        }
+
+        // distribute
+        for_chunks(m, threads, 1, [&](size_t tid, size_t b, size_t e) {
+            auto& pos = offset[tid];
+            for(size_t i = first + b; i < first + e; i++) {
+                const len_t d = dest(i);
+                buffer[pos[d / bucket_size]++] = entry_t { d, len_t(value(i)) };
+            }
+        });
+
+        // write the buckets
+        if(subs == 1) {
+            for_chunks(buckets, threads, 1, [&](size_t, size_t b, size_t e) {
+                for(size_t j = start[b]; j < start[e]; j++) {
+                    out[buffer[j].dest] = buffer[j].value;
+                }
+            });
+            continue;
+        }
+
+        // distribute each bucket to its sub-buckets first
+        for_chunks(buckets, threads, 1, [&](size_t, size_t b, size_t e) {
+            std::vector<entry_t> sorted;
+            std::vector<size_t> pos(subs);
+            for(size_t k = b; k < e; k++) {
+                const size_t f_end = std::min((k + 1) * subs, fines);
+                for(size_t f = k * subs; f < f_end; f++) {
+                    pos[f - k * subs] = fine_start[f] - start[k];
+                }
+
+                sorted.resize(start[k + 1] - start[k]);
+                for(size_t j = start[k]; j < start[k + 1]; j++) {
+                    const size_t f = buffer[j].dest / BUCKET_SIZE;
+                    sorted[pos[f - k * subs]++] = buffer[j];
+                }
+                for(auto& x : sorted) {
+                    out[x.dest] = x.value;
+                }
+            }
+        });
+    }
+}
+
+}} //ns
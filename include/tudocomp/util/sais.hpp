@@ -0,0 +1,334 @@
+/*
+ * This file integrates a customized version of sais-lite into tudocomp.
+ * sais-lite is licensed under the MIT License, which follows.
+ *
+ * Copyright (c) 2008-2010 Yuta Mori All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <tudocomp/def.hpp>
+
+namespace tdc {
+namespace sais {
+
+/// The smallest alphabet size for which bucket arrays are placed in the
+/// free space of the suffix array.
+constexpr size_t MIN_BUCKET_SIZE = 256;
+
+template<typename char_t, typename index_t>
+inline void get_counts(const char_t* T, index_t* C, index_t n, index_t k) {
+    std::fill(C, C + k, index_t(0));
+    for(index_t i = 0; i < n; ++i) ++C[index_t(T[i])];
+}
+
+template<typename index_t>
+inline void get_buckets(const index_t* C, index_t* B, index_t k, bool end) {
+    index_t sum = 0;
+    if(end) {
+        for(index_t i = 0; i < k; ++i) { sum += C[i]; B[i] = sum; }
+    } else {
+        for(index_t i = 0; i < k; ++i) { sum += C[i]; B[i] = sum - C[i]; }
+    }
+}
+
+/// Sorts all LMS substrings by inducing.
+template<typename char_t, typename index_t>
+inline void lms_sort(const char_t* T, index_t* SA, index_t* C, index_t* B,
+                     index_t n, index_t k) {
+    index_t *b, i, j;
+    index_t c0, c1;
+
+    // compute SAl
+    if(C == B) get_counts(T, C, n, k);
+    get_buckets(C, B, k, false);
+    j = n - 1;
+    b = SA + B[c1 = index_t(T[j])];
+    --j;
+    *b++ = (index_t(T[j]) < c1) ? ~j : j;
+    for(i = 0; i < n; ++i) {
+        if(0 < (j = SA[i])) {
+            DCHECK_GE(index_t(T[j]), index_t(T[j + 1]));
+            if((c0 = index_t(T[j])) != c1) { B[c1] = b - SA; b = SA + B[c1 = c0]; }
+            DCHECK_LT(i, b - SA);
+            --j;
+            *b++ = (index_t(T[j]) < c1) ? ~j : j;
+            SA[i] = 0;
+        } else if(j < 0) {
+            SA[i] = ~j;
+        }
+    }
+
+    // compute SAs
+    if(C == B) get_counts(T, C, n, k);
+    get_buckets(C, B, k, true);
+    for(i = n - 1, b = SA + B[c1 = 0]; 0 <= i; --i) {
+        if(0 < (j = SA[i])) {
+            DCHECK_LE(index_t(T[j]), index_t(T[j + 1]));
+            if((c0 = index_t(T[j])) != c1) { B[c1] = b - SA; b = SA + B[c1 = c0]; }
+            DCHECK_LE(b - SA, i);
+            --j;
+            *--b = (index_t(T[j]) > c1) ? ~(j + 1) : j;
+            SA[i] = 0;
+        }
+    }
+}
+
+/// Compacts the sorted LMS substrings into the first m entries of SA and
+/// names them lexicographically. Returns the amount of distinct names.
+template<typename char_t, typename index_t>
+inline index_t lms_postproc(const char_t* T, index_t* SA, index_t n, index_t m) {
+    index_t i, j, p, q, plen, qlen, name;
+    index_t c0, c1;
+    bool diff;
+
+    // compact all the sorted substrings into the first m items of SA,
+    // 2*m must be not larger than n (provable)
+    DCHECK_LT(0, n);
+    for(i = 0; (p = SA[i]) < 0; ++i) { SA[i] = ~p; DCHECK_LT(i + 1, n); }
+    if(i < m) {
+        for(j = i, ++i;; ++i) {
+            DCHECK_LT(i, n);
+            if((p = SA[i]) < 0) {
+                SA[j++] = ~p; SA[i] = 0;
+                if(j == m) break;
+            }
+        }
+    }
+
+    // store the length of all substrings
+    i = n - 1; j = n - 1; c0 = index_t(T[n - 1]);
+    do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+    for(; 0 <= i;) {
+        do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) <= c1));
+        if(0 <= i) {
+            SA[m + ((i + 1) >> 1)] = j - i; j = i + 1;
+            do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+        }
+    }
+
+    // find the lexicographic names of all substrings
+    for(i = 0, name = 0, q = n, qlen = 0; i < m; ++i) {
+        p = SA[i], plen = SA[m + (p >> 1)], diff = true;
+        if((plen == qlen) && ((q + plen) < n)) {
+            for(j = 0; (j < plen) && (T[p + j] == T[q + j]); ++j) {}
+            if(j == plen) diff = false;
+        }
+        if(diff) { ++name, q = p, qlen = plen; }
+        SA[m + (p >> 1)] = name;
+    }
+
+    return name;
+}
+
+/// Induces the suffix array from the sorted LMS suffixes.
+template<typename char_t, typename index_t>
+inline void induce_sa(const char_t* T, index_t* SA, index_t* C, index_t* B,
+                      index_t n, index_t k) {
+    index_t *b, i, j;
+    index_t c0, c1;
+
+    // compute SAl
+    if(C == B) get_counts(T, C, n, k);
+    get_buckets(C, B, k, false);
+    j = n - 1;
+    b = SA + B[c1 = index_t(T[j])];
+    *b++ = ((0 < j) && (index_t(T[j - 1]) < c1)) ? ~j : j;
+    for(i = 0; i < n; ++i) {
+        j = SA[i], SA[i] = ~j;
+        if(0 < j) {
+            --j;
+            DCHECK_GE(index_t(T[j]), index_t(T[j + 1]));
+            if((c0 = index_t(T[j])) != c1) { B[c1] = b - SA; b = SA + B[c1 = c0]; }
+            DCHECK_LT(i, b - SA);
+            *b++ = ((0 < j) && (index_t(T[j - 1]) < c1)) ? ~j : j;
+        }
+    }
+
+    // compute SAs
+    if(C == B) get_counts(T, C, n, k);
+    get_buckets(C, B, k, true);
+    for(i = n - 1, b = SA + B[c1 = 0]; 0 <= i; --i) {
+        if(0 < (j = SA[i])) {
+            --j;
+            DCHECK_LE(index_t(T[j]), index_t(T[j + 1]));
+            if((c0 = index_t(T[j])) != c1) { B[c1] = b - SA; b = SA + B[c1 = c0]; }
+            DCHECK_LE(b - SA, i);
+            *--b = ((j == 0) || (index_t(T[j - 1]) > c1)) ? ~j : j;
+        } else {
+            SA[i] = ~j;
+        }
+    }
+}
+
+/// Constructs the suffix array of T[0..n) over the alphabet [0..k).
+///
+/// SA must provide n + fs entries, of which the last fs entries may be
+/// used as additional work space. Bucket arrays are placed into that space
+/// if possible, otherwise they are allocated.
+template<typename char_t, typename index_t>
+inline void sais_main(const char_t* T, index_t* SA, index_t fs,
+                      index_t n, index_t k) {
+    std::vector<index_t> own_c, own_b;
+    index_t *C, *B, *RA, *b;
+    index_t i, j, m, p, q, name, newfs, dummy;
+    index_t c0, c1;
+    unsigned flags;
+
+    if(size_t(k) <= MIN_BUCKET_SIZE) {
+        own_c.resize(k); C = own_c.data();
+        if(k <= fs) {
+            B = SA + (n + fs - k);
+            flags = 1;
+        } else {
+            own_b.resize(k); B = own_b.data();
+            flags = 3;
+        }
+    } else if(k <= fs) {
+        C = SA + (n + fs - k);
+        if(k <= (fs - k)) {
+            B = C - k;
+            flags = 0;
+        } else if(size_t(k) <= (MIN_BUCKET_SIZE * 4)) {
+            own_b.resize(k); B = own_b.data();
+            flags = 2;
+        } else {
+            B = C;
+            flags = 8;
+        }
+    } else {
+        own_c.resize(k); C = B = own_c.data();
+        flags = 4 | 8;
+    }
+
+    // stage 1: reduce the problem by at least 1/2,
+    // sort all the LMS substrings
+    get_counts(T, C, n, k);
+    get_buckets(C, B, k, true);
+    std::fill(SA, SA + n, index_t(0));
+    b = &dummy; i = n - 1; j = n; m = 0; c0 = index_t(T[n - 1]);
+    do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+    for(; 0 <= i;) {
+        do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) <= c1));
+        if(0 <= i) {
+            *b = j; b = SA + --B[c1]; j = i; ++m;
+            do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+        }
+    }
+
+    if(1 < m) {
+        lms_sort(T, SA, C, B, n, k);
+        name = lms_postproc(T, SA, n, m);
+    } else if(m == 1) {
+        *b = j + 1;
+        name = 1;
+    } else {
+        name = 0;
+    }
+
+    // stage 2: solve the reduced problem,
+    // recurse if names are not yet unique
+    if(name < m) {
+        if(flags & 4) std::vector<index_t>().swap(own_c);
+        if(flags & 2) std::vector<index_t>().swap(own_b);
+
+        newfs = (n + fs) - (m * 2);
+        if((flags & (1 | 4 | 8)) == 0) {
+            if((k + name) <= newfs) newfs -= k;
+            else flags |= 8;
+        }
+        DCHECK_LE(n >> 1, newfs + m);
+
+        RA = SA + m + newfs;
+        for(i = m + (n >> 1) - 1, j = m - 1; m <= i; --i) {
+            if(SA[i] != 0) RA[j--] = SA[i] - 1;
+        }
+
+        sais_main(const_cast<const index_t*>(RA), SA, newfs, m, name);
+
+        i = n - 1; j = m - 1; c0 = index_t(T[n - 1]);
+        do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+        for(; 0 <= i;) {
+            do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) <= c1));
+            if(0 <= i) {
+                RA[j--] = i + 1;
+                do { c1 = c0; } while((0 <= --i) && ((c0 = index_t(T[i])) >= c1));
+            }
+        }
+        for(i = 0; i < m; ++i) SA[i] = RA[SA[i]];
+
+        if(flags & 4) { own_c.resize(k); C = B = own_c.data(); }
+        if(flags & 2) { own_b.resize(k); B = own_b.data(); }
+    }
+
+    // stage 3: induce the result for the original problem
+    if(flags & 8) get_counts(T, C, n, k);
+
+    // put all left-most S characters into their buckets
+    if(1 < m) {
+        get_buckets(C, B, k, true);
+        i = m - 1, j = n, p = SA[m - 1], c1 = index_t(T[p]);
+        do {
+            q = B[c0 = c1];
+            while(q < j) SA[--j] = 0;
+            do {
+                SA[--j] = p;
+                if(--i < 0) break;
+                p = SA[i];
+            } while((c1 = index_t(T[p])) == c0);
+        } while(0 <= i);
+        while(0 < j) SA[--j] = 0;
+    }
+
+    induce_sa(T, SA, C, B, n, k);
+}
+
+/// Constructs the suffix array of a text using SA-IS.
+///
+/// Apart from the suffix array itself, only the bucket arrays of the
+/// input alphabet are allocated. The reduced problems are solved within
+/// the suffix array.
+///
+/// \param T the text.
+/// \param SA the suffix array of size n.
+/// \param n the length of the text. It must be representable by index_t.
+template<typename index_t>
+inline void sais(const uliteral_t* T, index_t* SA, index_t n) {
+    static_assert(std::is_signed<index_t>::value, "index_t must be signed");
+    DCHECK_GE(n, 0);
+
+    if(n <= 1) {
+        if(n == 1) SA[0] = 0;
+        return;
+    }
+    sais_main(T, SA, index_t(0), n, index_t(ULITERAL_MAX + 1));
+}
+
+}} //ns
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <tudocomp_stat/Json.hpp>
 
@@ -30,8 +31,10 @@ public:
     unsigned long time_start;
     unsigned long time_end;
     ssize_t mem_off;
-    ssize_t mem_current;
-    ssize_t mem_peak;
+
+    // updated by all threads attached to the phase, see StatPhase
+    std::atomic<ssize_t> mem_current;
+    std::atomic<ssize_t> mem_peak;
 
     keyval* first_stat;
 
@@ -60,10 +63,14 @@ public:
 
     template<typename T>
     inline void log_stat(const char* key, const T& value) {
+        log_stat(key, std::to_string(value));
+    }
+
+    inline void log_stat(const char* key, const std::string& value) {
         keyval* kv = new keyval();
 
         strncpy(kv->key, key, STR_BUFFER_SIZE);
-        strncpy(kv->val, std::to_string(value).c_str(), STR_BUFFER_SIZE);
+        strncpy(kv->val, value.c_str(), STR_BUFFER_SIZE);
 
         if(first_stat) {
             keyval* last = first_stat;
@@ -82,8 +89,8 @@ public:
         obj.set("timeStart", time_start);
         obj.set("timeEnd",   time_end);
         obj.set("memOff",    mem_off);
-        obj.set("memPeak",   mem_peak);
-        obj.set("memFinal",  mem_current);
+        obj.set("memPeak",   mem_peak.load());
+        obj.set("memFinal",  mem_current.load());
 
         json::Array stats;
         keyval* kv = first_stat;
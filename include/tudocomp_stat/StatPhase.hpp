@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstring>
 #include <ctime>
 #include <string>
@@ -20,7 +21,9 @@ namespace tdc {
 /// use in the tudocomp charter for visualization or third party applications.
 class StatPhase {
 private:
-    static StatPhase* s_current;
+    // the current phase of each thread; worker threads attach to the
+    // phase of the thread that started them, see \ref attach
+    static thread_local StatPhase* s_current;
 
     inline static unsigned long current_time_millis() {
         timespec t;
@@ -32,7 +35,8 @@ private:
     StatPhase* m_parent;
     PhaseData* m_data;
 
-    bool m_track_memory;
+    // read by all threads attached to the phase in the malloc hooks
+    std::atomic<bool> m_track_memory;
 
     inline void append_child(PhaseData* data) {
         if(m_data->first_child) {
@@ -46,17 +50,23 @@ private:
         }
     }
 
+    // the memory counters are shared between threads, but only need to be
+    // consistent by themselves, so they are updated with relaxed atomics
+    // rather than under a lock
     inline void track_alloc_internal(size_t bytes) {
-        if(m_track_memory) {
-            m_data->mem_current += bytes;
-            m_data->mem_peak = std::max(m_data->mem_peak, m_data->mem_current);
+        if(m_track_memory.load(std::memory_order_relaxed)) {
+            const ssize_t current = m_data->mem_current.fetch_add(
+                bytes, std::memory_order_relaxed) + bytes;
+            ssize_t peak = m_data->mem_peak.load(std::memory_order_relaxed);
+            while(current > peak && !m_data->mem_peak.compare_exchange_weak(
+                peak, current, std::memory_order_relaxed)) {}
             if(m_parent) m_parent->track_alloc_internal(bytes);
         }
     }
 
     inline void track_free_internal(size_t bytes) {
-        if(m_track_memory) {
-            m_data->mem_current -= bytes;
+        if(m_track_memory.load(std::memory_order_relaxed)) {
+            m_data->mem_current.fetch_sub(bytes, std::memory_order_relaxed);
             if(m_parent) m_parent->track_free_internal(bytes);
         }
     }
@@ -77,7 +87,7 @@ private:
         if(m_parent) m_parent->resume();
         m_data->title(title);
 
-        m_data->mem_off = m_parent ? m_parent->m_data->mem_current : 0;
+        m_data->mem_off = m_parent ? m_parent->m_data->mem_current.load() : 0;
         m_data->mem_current = 0;
         m_data->mem_peak = 0;
 
@@ -167,6 +177,24 @@ public:
         if(s_current) s_current->track_free_internal(bytes);
     }
 
+    /// \brief Returns the current phase of the calling thread, or
+    ///        \c nullptr if there is none.
+    inline static StatPhase* current() {
+        return s_current;
+    }
+
+    /// \brief Makes a phase the current phase of the calling thread.
+    ///
+    /// Worker threads call this first to attribute their allocations to the
+    /// phase of the thread that started them. This includes the thread's
+    /// own bookkeeping, which is freed when the thread exits, so the phase
+    /// must outlive the thread.
+    ///
+    /// \param phase the phase to attach to
+    inline static void attach(StatPhase* phase) {
+        s_current = phase;
+    }
+
     /// \brief Pauses the tracking of memory allocations in the current phase.
     ///
     /// Memory tracking is paused until \ref pause_tracking is called or the
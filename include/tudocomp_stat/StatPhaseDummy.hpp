@@ -38,6 +38,13 @@ public:
     inline static void track_free(size_t bytes) {
     }
 
+    inline static StatPhaseDummy* current() {
+        return nullptr;
+    }
+
+    inline static void attach(StatPhaseDummy* phase) {
+    }
+
     inline static void pause_tracking() {
     }
 
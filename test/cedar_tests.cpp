@@ -8,8 +8,11 @@
 #include <tudocomp/compressors/lz78/BinaryTrie.hpp>
 #include <tudocomp/compressors/lz78/TernaryTrie.hpp>
 #include <tudocomp/compressors/lz78/CedarTrie.hpp>
+#include <tudocomp/compressors/lz78/SwissTrie.hpp>
+#include <tudocomp/compressors/lz78/CompactHashTrie.hpp>
 #include <tudocomp/coders/ASCIICoder.hpp>
 #include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
 
 struct InputOutput {
     View in;
@@ -102,6 +105,50 @@ INSTANTIATE_TEST_CASE_P(InputOutput,
                             InputOutput { "\xff\xff\xff"_v, "255:256:\0"_v }
                         ));
 
+TEST(Lz78Decompress, roundtrip) {
+    // longer than a flush of the decoded text, with long factors
+    const size_t n = 3 * lz78::Decompressor::FLUSH_SIZE;
+    test::roundtrip<LZ78Compressor<BitCoder, lz78::BinaryTrie>>(
+        RandomUniformGenerator::generate(n, 1, 'a', 'd'));
+    test::roundtrip<LZ78Compressor<BitCoder, lz78::BinaryTrie>>(
+        std::string(n, 'a') + "b");
+}
+
+TEST(LzwDecompress, roundtrip) {
+    // a run consists of KwKwK codes only
+    const size_t n = 3 * lzw::Decoder::FLUSH_SIZE;
+    test::roundtrip<LZWCompressor<BitCoder, lz78::BinaryTrie>>(
+        RandomUniformGenerator::generate(n, 1, 'a', 'd'));
+    test::roundtrip<LZWCompressor<BitCoder, lz78::BinaryTrie>>(
+        std::string(n, 'a') + "b");
+
+    // dictionary resets
+    for(auto dict_size : { "257", "300", "4096" }) {
+        const std::string options = std::string("dict_size=") + dict_size;
+        test::roundtrip_ex<LZWCompressor<BitCoder, lz78::BinaryTrie>>(
+            RandomUniformGenerator::generate(20000, 1, 'a', 'd'), "", options);
+        test::roundtrip_ex<LZWCompressor<BitCoder, lz78::BinaryTrie>>(
+            std::string(20000, 'a'), "", options);
+    }
+}
+
+template<typename trie_t>
+class HashTrieRoundtrip : public ::testing::Test {};
+
+using HashTries = ::testing::Types<lz78::SwissTrie, lz78::CompactHashTrie>;
+TYPED_TEST_CASE(HashTrieRoundtrip, HashTries);
+
+TYPED_TEST(HashTrieRoundtrip, roundtrip) {
+    // the tables grow several times, which restores the keys of the compact
+    // hash trie from their quotients, and are cleared by dictionary resets
+    for(auto text : { RandomUniformGenerator::generate(1 << 20, 1, 'a', 'z'),
+                      RandomUniformGenerator::generate(1 << 18, 2, 0, 255) }) {
+        test::roundtrip<LZ78Compressor<BitCoder, TypeParam>>(text);
+        test::roundtrip<LZWCompressor<BitCoder, TypeParam>>(text);
+        test::roundtrip_ex<LZWCompressor<BitCoder, TypeParam>>(text, "", "dict_size=1000");
+    }
+}
+
 /*
 TEST(zcedar, base) {
     cedar::da<uint32_t> trie;
@@ -10,10 +10,13 @@
 #include <tudocomp/generators/ThueMorseGenerator.hpp>
 
 #include <tudocomp/coders/ASCIICoder.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+#include <tudocomp/coders/ContextCoder.hpp>
 #include <tudocomp/coders/EliasDeltaCoder.hpp>
 #include <tudocomp/coders/EliasGammaCoder.hpp>
 #include <tudocomp/coders/HuffmanCoder.hpp>
 #include <tudocomp/coders/SLECoder.hpp>
+#include <tudocomp/coders/StreamVByteCoder.hpp>
 #include <tudocomp/coders/ArithmeticCoder.hpp>
 #include <tudocomp/coders/TernaryCoder.hpp>
 #include <tudocomp/coders/AdaptiveHuffmanCoder.hpp>
@@ -186,50 +189,220 @@ void test_mixed() {
     }
 }
 
+template<typename coder_t>
+void test_many() {
+    // Encode blocks of integers sharing a range, separated by single bits
+    // so that blocks start at arbitrary bit positions
+    const std::vector<Range> ranges {
+        Range(1), Range(255), Range(3, 1000), Range(65535),
+        Range(std::numeric_limits<uint32_t>::max()), Range(7, 1ULL << 20)
+    };
+
+    std::vector<std::vector<uint32_t>> blocks;
+    for(size_t k = 0; k < ranges.size(); k++) {
+        const Range& r = ranges[k];
+        std::vector<uint32_t> block;
+        for(size_t i = 0; i < 100 + 7 * k; i++) {
+            block.push_back(uint32_t(r.min() + (i * 2654435761ULL) % (r.delta() + 1)));
+        }
+        blocks.push_back(std::move(block));
+    }
+
+    std::vector<uint64_t> wide;
+    const Range wide_r(1ULL << 60);
+    for(uint64_t i = 0; i < 50; i++) wide.push_back(i * 0x9E3779B97F4A7C15ULL >> 4);
+
+    auto encode = [&](std::stringstream& ss, bool bulk) {
+        Output out(ss);
+        typename coder_t::Encoder coder(create_env(coder_t::meta()), out, DUMMY_LITERALS);
+
+        for(size_t k = 0; k < ranges.size(); k++) {
+            coder.encode(k % 2, bit_r);
+            if(bulk) {
+                coder.encode_many(blocks[k].data(), blocks[k].size(), ranges[k]);
+            } else {
+                for(auto v : blocks[k]) coder.encode(v, ranges[k]);
+            }
+        }
+
+        if(bulk) {
+            coder.encode_many(wide.data(), wide.size(), wide_r);
+        } else {
+            for(auto v : wide) coder.encode(v, wide_r);
+        }
+    };
+
+    std::stringstream ss_bulk, ss_scalar;
+    encode(ss_bulk, true);
+    encode(ss_scalar, false);
+
+    // Bulk encoding must be indistinguishable from scalar encoding
+    std::string result = ss_bulk.str();
+    ASSERT_EQ(ss_scalar.str(), result);
+
+    // Decode
+    {
+        Input in(result);
+        typename coder_t::Decoder decoder(create_env(coder_t::meta()), in);
+
+        for(size_t k = 0; k < ranges.size(); k++) {
+            ASSERT_EQ(k % 2, decoder.template decode<size_t>(bit_r));
+
+            std::vector<uint32_t> block(blocks[k].size());
+            decoder.decode_many(block.data(), block.size(), ranges[k]);
+            ASSERT_EQ(blocks[k], block) << "k=" << k;
+        }
+
+        std::vector<uint64_t> wide_dec(wide.size());
+        decoder.decode_many(wide_dec.data(), wide_dec.size(), wide_r);
+        ASSERT_EQ(wide, wide_dec);
+
+        ASSERT_TRUE(decoder.eof());
+    }
+}
+
 TEST(coder, ascii_mt) { test_mt<ASCIICoder>(); }
 TEST(coder, ascii_bits) { test_bits<ASCIICoder>(); }
 TEST(coder, ascii_int) { test_int<ASCIICoder>(); }
 TEST(coder, ascii_str) { test_str<ASCIICoder>(); }
 TEST(coder, ascii_mixed) { test_mixed<ASCIICoder>(); }
+TEST(coder, ascii_many) { test_many<ASCIICoder>(); }
+
+TEST(coder, bit_mt) { test_mt<BitCoder>(); }
+TEST(coder, bit_bits) { test_bits<BitCoder>(); }
+TEST(coder, bit_int) { test_int<BitCoder>(); }
+TEST(coder, bit_str) { test_str<BitCoder>(); }
+TEST(coder, bit_mixed) { test_mixed<BitCoder>(); }
+TEST(coder, bit_many) { test_many<BitCoder>(); }
 
 TEST(coder, sle_mt) { test_mt<SLECoder>(); }
 TEST(coder, sle_bits) { test_bits<SLECoder>(); }
 TEST(coder, sle_int) { test_int<SLECoder>(); }
 TEST(coder, sle_str) { test_str<SLECoder>(); }
 TEST(coder, sle_mixed) { test_mixed<SLECoder>(); }
+TEST(coder, sle_many) { test_many<SLECoder>(); }
 
 TEST(coder, delta_mt) { test_mt<EliasDeltaCoder>(); }
 TEST(coder, delta_bits) { test_bits<EliasDeltaCoder>(); }
 TEST(coder, delta_int) { test_int<EliasDeltaCoder>(); }
 TEST(coder, delta_str) { test_str<EliasDeltaCoder>(); }
 TEST(coder, delta_mixed) { test_mixed<EliasDeltaCoder>(); }
+TEST(coder, delta_many) { test_many<EliasDeltaCoder>(); }
 
 TEST(coder, gamma_mt) { test_mt<EliasGammaCoder>(); }
 TEST(coder, gamma_bits) { test_bits<EliasGammaCoder>(); }
 TEST(coder, gamma_int) { test_int<EliasDeltaCoder>(); }
 TEST(coder, gamma_str) { test_str<EliasDeltaCoder>(); }
 TEST(coder, gamma_mixed) { test_mixed<EliasDeltaCoder>(); }
+TEST(coder, gamma_many) { test_many<EliasGammaCoder>(); }
 
 TEST(coder, huff_mt) { test_mt<HuffmanCoder>(); }
 TEST(coder, huff_bits) { test_bits<HuffmanCoder>(); }
 TEST(coder, huff_int) { test_int<HuffmanCoder>(); }
 TEST(coder, huff_str) { test_str<HuffmanCoder>(); }
 TEST(coder, huff_mixed) { test_mixed<HuffmanCoder>(); }
+TEST(coder, huff_many) { test_many<HuffmanCoder>(); }
 
 TEST(coder, arithm_mt) { test_mt<ArithmeticCoder>(); }
 TEST(coder, arithm_bits) { test_bits<ArithmeticCoder>(); }
 TEST(coder, arithm_int) { test_int<ArithmeticCoder>(); }
 TEST(coder, arithm_str) { test_str<ArithmeticCoder>(); }
 TEST(coder, arithm_mixed) { test_mixed<ArithmeticCoder>(); }
+TEST(coder, arithm_many) { test_many<ArithmeticCoder>(); }
 
 TEST(coder, ternary_mt) { test_mt<TernaryCoder>(); }
 TEST(coder, ternary_bits) { test_bits<TernaryCoder>(); }
 TEST(coder, ternary_int) { test_int<TernaryCoder>(); }
 TEST(coder, ternary_str) { test_str<TernaryCoder>(); }
 TEST(coder, ternary_mixed) { test_mixed<TernaryCoder>(); }
+TEST(coder, ternary_many) { test_many<TernaryCoder>(); }
 
 TEST(coder, adaphuff_mt) { test_mt<AdaptiveHuffmanCoder>(); }
 TEST(coder, adaphuff_bits) { test_bits<AdaptiveHuffmanCoder>(); }
 TEST(coder, adaphuff_int) { test_int<AdaptiveHuffmanCoder>(); }
 TEST(coder, adaphuff_str) { test_str<AdaptiveHuffmanCoder>(); }
 TEST(coder, adaphuff_mixed) { test_mixed<AdaptiveHuffmanCoder>(); }
+TEST(coder, adaphuff_many) { test_many<AdaptiveHuffmanCoder>(); }
+
+TEST(coder, svbyte_mt) { test_mt<StreamVByteCoder>(); }
+TEST(coder, svbyte_bits) { test_bits<StreamVByteCoder>(); }
+TEST(coder, svbyte_int) { test_int<StreamVByteCoder>(); }
+TEST(coder, svbyte_str) { test_str<StreamVByteCoder>(); }
+TEST(coder, svbyte_mixed) { test_mixed<StreamVByteCoder>(); }
+TEST(coder, svbyte_many) { test_many<StreamVByteCoder>(); }
+
+TEST(coder, svbyte_blocks) {
+    // Interleave integers, bits and literals across several blocks
+    const size_t n = 3 * StreamVByteCoder::BLOCK_SIZE + 5;
+    const Range r(1ULL << 40);
+
+    std::stringstream ss;
+    {
+        Output out(ss);
+        StreamVByteCoder::Encoder coder(create_env(StreamVByteCoder::meta()), out, DUMMY_LITERALS);
+
+        for(size_t i = 0; i < n; i++) {
+            coder.encode(i * i, r);
+            if(i % 7 == 0) {
+                coder.encode(i % 3 == 0, bit_r);
+            }
+            if(i % 5 == 0) {
+                coder.encode(uliteral_t(i), literal_r);
+            }
+        }
+    }
+
+    std::string result = ss.str();
+    {
+        Input in(result);
+        StreamVByteCoder::Decoder decoder(create_env(StreamVByteCoder::meta()), in);
+
+        size_t i = 0;
+        while(!decoder.eof()) {
+            ASSERT_EQ(i * i, decoder.template decode<size_t>(r));
+            if(i % 7 == 0) {
+                ASSERT_EQ(i % 3 == 0, decoder.template decode<bool>(bit_r));
+            }
+            if(i % 5 == 0) {
+                ASSERT_EQ(uliteral_t(i), decoder.template decode<uliteral_t>(literal_r));
+            }
+            ++i;
+        }
+
+        ASSERT_EQ(n, i);
+    }
+}
+
+TEST(coder, context_mt) { test_mt<ContextCoder>(); }
+TEST(coder, context_bits) { test_bits<ContextCoder>(); }
+TEST(coder, context_int) { test_int<ContextCoder>(); }
+TEST(coder, context_str) { test_str<ContextCoder>(); }
+TEST(coder, context_mixed) { test_mixed<ContextCoder>(); }
+TEST(coder, context_many) { test_many<ContextCoder>(); }
+
+TEST(coder, context_predictable_bits) {
+    // A highly predictable flag sequence must take far less than a bit each
+    const size_t n = 100000;
+
+    std::stringstream ss;
+    {
+        Output out(ss);
+        ContextCoder::Encoder coder(create_env(ContextCoder::meta()), out, DUMMY_LITERALS);
+        for(size_t i = 0; i < n; i++) coder.encode(i % 64 == 0, bit_r);
+    }
+
+    std::string result = ss.str();
+    ASSERT_LT(result.size(), n / 8 / 4);
+
+    {
+        Input in(result);
+        ContextCoder::Decoder decoder(create_env(ContextCoder::meta()), in);
+
+        size_t i = 0;
+        while(!decoder.eof()) {
+            ASSERT_EQ(i % 64 == 0, decoder.template decode<bool>(bit_r)) << "i=" << i;
+            ++i;
+        }
+        ASSERT_EQ(n, i);
+    }
+}
@@ -1,14 +1,25 @@
 #include <string>
 #include <vector>
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include <gtest/gtest.h>
 
 #include <sdsl/int_vector.hpp>
 
 #include <tudocomp/io.hpp>
 #include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/ds/SAParallel.hpp>
+#include <tudocomp/ds/SAIS.hpp>
+#include <tudocomp/ds/SAExternal.hpp>
+#include <tudocomp/ds/PLCPParallel.hpp>
+#include <tudocomp/ds/LCPParallel.hpp>
+#include <tudocomp/ds/LCPFromBWT.hpp>
+#include <tudocomp/ds/LCPSuccinct.hpp>
 #include <tudocomp/ds/uint_t.hpp>
 #include <tudocomp/ds/bwt.hpp>
+#include <tudocomp/compressors/BWTCompressor.hpp>
 #include <tudocomp/CreateAlgorithm.hpp>
 #include "test/util.hpp"
 
@@ -123,29 +134,425 @@ void test_all_ds(const std::string& str, textds_t& t) {
 template<class textds_t>
 class RunTestDS {
 	void (*m_testfunc)(const std::string&, textds_t&);
+	std::string m_options;
 	public:
-	RunTestDS(void (*testfunc)(const std::string&, textds_t&))
-		: m_testfunc(testfunc) {}
+	RunTestDS(void (*testfunc)(const std::string&, textds_t&),
+	          const std::string& options = "")
+		: m_testfunc(testfunc), m_options(options) {}
 
 	void operator()(const std::string& str) {
 		VLOG(2) << "str = \"" << str << "\"" << " size: " << str.length();
 		test::TestInput input = test::compress_input(str);
 		InputView in = input.as_view();
 		DCHECK_EQ(str.length()+1, in.size());
-		textds_t t = create_algo<textds_t>("", in);
+		textds_t t = create_algo<textds_t>(m_options, in);
 		DCHECK_EQ(str.length()+1, t.size());
 		m_testfunc(str, t);
 	}
 };
 
+template<class textds_t>
+void test_divbwt(const std::string& str, textds_t& t) {
+	auto& sa = t.require_sa();
+
+	const len_t input_size = str.length()+1;
+	std::vector<saidx_t> bwt(input_size);
+	const saidx_t pidx = divbwt(t.text(), bwt, input_size);
+	ASSERT_GE(pidx, 0);
+	ASSERT_EQ(sa[pidx], 0U);
+	for(size_t i = 0; i < input_size; ++i) {
+		ASSERT_EQ(uliteral_t(bwt[i]), bwt::bwt(t,sa,i)) << "at i=" << i;
+	}
+};
+
+template<class textds_t>
+void test_bwt_sampled(const std::string& str, textds_t& t) {
+	auto& isa = t.require_isa();
+
+	const len_t input_size = str.length()+1;
+	for(size_t step : { 1, 3, 64 }) {
+		std::vector<saidx_t> bwt(input_size);
+		std::vector<len_t> rows((input_size >= 2) ? (input_size - 2) / step : 0);
+		divbwt(t.text(), bwt, input_size, [&](saidx_t s, saidx_t i) {
+			ASSERT_EQ(isa[s], len_t(i)) << "at s=" << s;
+			if(s % step == 0 && s / step <= rows.size()) rows[s / step - 1] = i;
+		});
+
+		std::vector<uliteral_t> bytes(bwt.begin(), bwt.end());
+		for(size_t threads : { 1, 4 }) {
+			uliteral_t* decoded_string = bwt::decode_bwt_sampled(bytes, rows, step, threads);
+			std::string decoded;
+			decoded.assign(reinterpret_cast<char*>(decoded_string));
+			delete [] decoded_string;
+			ASSERT_EQ(decoded, str);
+		}
+	}
+};
+
+TEST(ds, BWTCompressor) {
+	const std::string str = RandomUniformGenerator::generate(10000, 1, 'a', 'c');
+	for(auto& options : { "direct=true", "direct=false",
+	                      "direct=true, samples=8", "direct=false, samples=8" }) {
+		test::roundtrip_ex<BWTCompressor<>>(str, "", options);
+	}
+
+	// a trailer of samples cut short is rejected
+	auto e = test::compress<BWTCompressor<>>(str, "samples=8");
+	for(size_t cut : { size_t(8), size_t(24) }) {
+		std::vector<uint8_t> bytes(e.bytes.begin(), e.bytes.end() - cut);
+		std::vector<uint8_t> decoded;
+		Input in = Input::from_memory(bytes);
+		Output out = Output::from_memory(decoded);
+		auto compressor = create_algo<BWTCompressor<>>("samples=8");
+		ASSERT_THROW(compressor.decompress(in, out), std::runtime_error);
+	}
+}
+
 #define TEST_DS_STRINGCOLLECTION(func) \
 	RunTestDS<TextDS<>> runner(func); \
 	test::roundtrip_batch(runner); \
 	test::on_string_generators(runner,11);
 TEST(ds, SA)          { TEST_DS_STRINGCOLLECTION(test_sa); }
 TEST(ds, BWT)         { TEST_DS_STRINGCOLLECTION(test_bwt); }
+TEST(ds, DirectBWT)   { TEST_DS_STRINGCOLLECTION(test_divbwt); }
+TEST(ds, SampledBWT)  { TEST_DS_STRINGCOLLECTION(test_bwt_sampled); }
 TEST(ds, LCP)         { TEST_DS_STRINGCOLLECTION(test_lcp); }
 TEST(ds, ISA)         { TEST_DS_STRINGCOLLECTION(test_isa); }
 TEST(ds, Integration) { TEST_DS_STRINGCOLLECTION(test_all_ds); }
 #undef TEST_DS_STRINGCOLLECTION
 
+
+template<class textds_t>
+void test_sa_equal(const std::string& options, const std::string& str) {
+	test::TestInput input = test::compress_input(str);
+	InputView in = input.as_view();
+
+	auto expected = create_algo<TextDS<>>("", in);
+	auto t = create_algo<textds_t>(options, in);
+
+	auto& sa_expected = expected.require_sa();
+	auto& sa = t.require_sa();
+	ASSERT_EQ(sa.size(), sa_expected.size());
+	for(size_t i = 0; i < sa.size(); ++i) {
+		ASSERT_EQ(sa[i], sa_expected[i]);
+	}
+}
+
+template<class textds_t>
+void test_lcp_equal(const std::string& options, const std::string& str) {
+	test::TestInput input = test::compress_input(str);
+	InputView in = input.as_view();
+
+	auto expected = create_algo<TextDS<>>("", in);
+	auto t = create_algo<textds_t>(options, in);
+
+	auto& lcp_expected = expected.require_lcp();
+	auto& lcp = t.require_lcp();
+	ASSERT_EQ(lcp.max_lcp(), lcp_expected.max_lcp());
+	ASSERT_EQ(lcp.size(), lcp_expected.size());
+	for(size_t i = 0; i < lcp.size(); ++i) {
+		ASSERT_EQ(lcp[i], lcp_expected[i]);
+	}
+}
+
+TEST(ds, SAParallel) {
+	RunTestDS<TextDS<SAParallel>> runner(test_all_ds, "sa=parallel(threads=4)");
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, SAParallelLarge) {
+	// long runs form large groups that are sorted by all threads
+	std::string str(200000, 'a');
+	for(size_t i = 0; i < str.size(); i += 1000 + i % 7) str[i] = 'b';
+	test_sa_equal<TextDS<SAParallel>>("sa=parallel(threads=4)", str);
+	test_sa_equal<TextDS<SAParallel>>("sa=parallel(threads=1)", str);
+}
+
+TEST(ds, SAIS) {
+	RunTestDS<TextDS<SAIS>> runner(test_all_ds);
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, SAISRecursion) {
+	// small alphabets and repetitions cause several levels of recursion
+	for(size_t seed = 1; seed <= 20; ++seed) {
+		test_sa_equal<TextDS<SAIS>>("", RandomUniformGenerator::generate(
+			5000 + seed, seed, 'a', 'a' + seed % 3 + 1));
+	}
+
+	std::string str;
+	for(size_t i = 0; i < 200; ++i) str += FibonacciGenerator::generate(i % 15 + 1);
+	test_sa_equal<TextDS<SAIS>>("", str);
+}
+
+TEST(ds, SACompressModes) {
+	// divsufsort runs on a native array unless compressing during
+	// construction saves memory
+	for(size_t seed = 1; seed <= 5; ++seed) {
+		const std::string str = RandomUniformGenerator::generate(
+			1000 * seed, seed, 'a', 'd');
+		test_sa_equal<TextDS<>>("compress=\"compressed\"", str);
+		test_sa_equal<TextDS<>>("compress=\"plain\"", str);
+	}
+}
+
+TEST(ds, SAExternal) {
+	RunTestDS<TextDS<SAExternal>> runner(test_all_ds);
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, SAExternalRuns) {
+	// a small memory budget forces sorting with several runs per round
+	std::string str;
+	for(size_t i = 0; i < 30; ++i) {
+		str += RandomUniformGenerator::generate(10000, i + 1, 'a', 'c');
+		str += FibonacciGenerator::generate(12);
+	}
+	test_sa_equal<TextDS<SAExternal>>("sa=external(memory=1)", str);
+}
+
+TEST(ds, ISAPhiParallel) {
+	// large enough to be scattered in several buckets and batches
+	const std::string str = RandomUniformGenerator::generate(300000, 1, 'a', 'z');
+	for(auto& cm : { "\"delayed\"", "\"compressed\"" }) {
+		for(auto& threads : { "1", "4" }) {
+			const std::string options =
+				std::string("compress=") + cm +
+				", phi=from_sa(threads=" + threads + ")" +
+				", isa=from_sa(threads=" + threads + ")";
+
+			test::TestInput input = test::compress_input(str);
+			InputView in = input.as_view();
+			auto t = create_algo<TextDS<>>(options, in);
+
+			auto& sa = t.require_sa();
+			auto& phi = t.require_phi();
+			auto& isa = t.require_isa();
+			ASSERT_EQ(phi.size(), sa.size());
+			ASSERT_EQ(isa.size(), sa.size());
+			for(size_t i = 0; i < sa.size(); ++i) {
+				ASSERT_EQ(isa[sa[i]], i);
+				ASSERT_EQ(phi[sa[i]], sa[(i > 0) ? i - 1 : sa.size() - 1]);
+			}
+		}
+	}
+}
+
+using TextDSParallelLCP = TextDS<SADivSufSort, PhiFromSA, PLCPParallel, LCPParallel>;
+
+TEST(ds, LCPParallel) {
+	RunTestDS<TextDSParallelLCP> runner(test_all_ds,
+		"plcp=parallel(threads=4), lcp=parallel(threads=4)");
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, LCPParallelLarge) {
+	// segment borders fall into long repetitions
+	std::string str;
+	for(size_t i = 0; i < 20; ++i) {
+		str += RandomUniformGenerator::generate(5000, i + 1, 'a', 'c');
+		str += FibonacciGenerator::generate(18);
+	}
+
+	for(auto& cm : { "\"delayed\"", "\"compressed\"" }) {
+		test_lcp_equal<TextDSParallelLCP>(std::string("compress=") + cm +
+			", plcp=parallel(threads=4), lcp=parallel(threads=4)", str);
+	}
+}
+
+using TextDSLCPFromBWT = TextDS<SADivSufSort, PhiFromSA, PLCPFromPhi, LCPFromBWT>;
+
+TEST(ds, LCPFromBWT) {
+	RunTestDS<TextDSLCPFromBWT> runner(test_all_ds);
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, LCPFromBWTLarge) {
+	// many intervals per level are queued as bit vectors, long runs cause
+	// many levels
+	for(auto& str : {
+		RandomUniformGenerator::generate(300000, 1, 'a', 'b'),
+		std::string(50000, 'a') }) {
+
+		test_lcp_equal<TextDSLCPFromBWT>("compress=\"compressed\"", str);
+	}
+}
+
+using TextDSLCPSuccinct = TextDS<SADivSufSort, PhiFromSA, PLCPFromPhi, LCPSuccinct>;
+
+TEST(ds, LCPSuccinct) {
+	RunTestDS<TextDSLCPSuccinct> runner(test_all_ds);
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, LCPSuccinctLarge) {
+	// long runs cause long gaps in the bit vector
+	for(auto& str : {
+		RandomUniformGenerator::generate(300000, 1, 'a', 'd'),
+		std::string(50000, 'a') + RandomUniformGenerator::generate(50000, 2, 'a', 'z') }) {
+
+		test_lcp_equal<TextDSLCPSuccinct>("", str);
+
+		test::TestInput input = test::compress_input(str);
+		InputView in = input.as_view();
+
+		auto expected = create_algo<TextDS<>>("", in);
+		auto t = create_algo<TextDSLCPSuccinct>("", in);
+
+		// the SA is kept for accesses even if only the LCP is requested
+		auto p = t.plan(ds::LCP);
+		ASSERT_EQ(p.steps.back().discard, ds::PLCP);
+		t.require(ds::LCP);
+
+		auto& lcp_expected = expected.require_lcp();
+		auto data = t.release_lcp().relinquish();
+		ASSERT_EQ(data.width(), bits_for(lcp_expected.max_lcp()));
+		for(size_t i = 0; i < data.size(); ++i) {
+			ASSERT_EQ(len_t(data[i]), len_t(lcp_expected[i]));
+		}
+	}
+}
+
+TEST(ds, Plan) {
+	const std::string str = "abcabcabc";
+	test::TestInput input = test::compress_input(str);
+	InputView in = input.as_view();
+
+	using ds::dsflags_t;
+	const dsflags_t flags = ds::SA | ds::ISA | ds::LCP;
+
+	auto time = create_algo<TextDS<>>("plan=\"time\"", in);
+	auto memory = create_algo<TextDS<>>("plan=\"memory\"", in);
+
+	// LCP is constructed before ISA so PLCP is gone when ISA is allocated
+	auto p = time.plan(flags);
+	ASSERT_EQ(p.to_string(), "SA PHI PLCP LCP ISA");
+	ASSERT_EQ(p.steps[2].discard, dsflags_t(0));
+	ASSERT_EQ(p.steps[3].discard, ds::PLCP);
+	ASSERT_EQ(p.steps[4].compress, ds::SA | ds::ISA);
+	ASSERT_EQ(p.peak, 3 * LEN_BITS * in.size() / 8);
+
+	// compressing early lowers the peak
+	auto q = memory.plan(flags);
+	ASSERT_EQ(q.steps[0].compress, ds::SA);
+	ASSERT_LT(q.peak, p.peak);
+
+	// the SA is only kept until the LCP array is constructed
+	auto r = time.plan(ds::LCP);
+	ASSERT_EQ(r.to_string(), "SA PHI PLCP LCP");
+	ASSERT_EQ(r.steps[3].discard, ds::SA | ds::PLCP);
+}
+
+template<class textds_t>
+void test_require(const std::string& str, textds_t& t) {
+	t.require(textds_t::SA | textds_t::ISA | textds_t::LCP);
+	test_all_ds(str, t);
+}
+
+TEST(ds, PlanMemory) {
+	RunTestDS<TextDS<>> runner(test_require, "plan=\"memory\"");
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, PlanTime) {
+	RunTestDS<TextDS<>> runner(test_require, "plan=\"time\"");
+	test::roundtrip_batch(runner);
+	test::on_string_generators(runner,11);
+}
+
+TEST(ds, Storage) {
+	// uncompressed arrays of 300000 entries are mapped
+	const std::string str = RandomUniformGenerator::generate(300000, 1, 'a', 'd');
+	test::TestInput input = test::compress_input(str);
+	InputView in = input.as_view();
+
+	auto expected = create_algo<TextDS<>>("", in);
+	expected.require(ds::SA | ds::ISA | ds::LCP);
+
+	for(auto storage : { "storage=\"hugepages\"", "storage=\"file\", scratch=\"/tmp\"" }) {
+		auto t = create_algo<TextDS<>>(storage, in);
+		t.require(ds::SA | ds::ISA | ds::LCP);
+		ASSERT_NE(nullptr, t.require_sa().storage());
+		ASSERT_EQ(nullptr, expected.require_sa().storage());
+
+		for(size_t i = 0; i < t.size(); ++i) {
+			ASSERT_EQ(t.require_sa()[i], expected.require_sa()[i]);
+			ASSERT_EQ(t.require_isa()[i], expected.require_isa()[i]);
+			ASSERT_EQ(t.require_lcp()[i], expected.require_lcp()[i]);
+		}
+	}
+}
+
+TEST(ds, IndexCache) {
+	char dir_template[] = "/tmp/tudocomp_cache_XXXXXX";
+	const std::string dir = mkdtemp(dir_template);
+	const std::string options = "cache=\"" + dir + "\"";
+
+	const std::string str = RandomUniformGenerator::generate(10000, 1, 'a', 'd');
+	test::TestInput input = test::compress_input(str);
+	InputView in = input.as_view();
+
+	auto count_files = [&]() {
+		size_t count = 0;
+		DIR* d = opendir(dir.c_str());
+		while(dirent* e = readdir(d)) if(e->d_name[0] != '.') ++count;
+		closedir(d);
+		return count;
+	};
+
+	// the first run stores all arrays, the second loads them
+	for(size_t run = 0; run < 2; ++run) {
+		auto t = create_algo<TextDS<>>(options, in);
+		t.require(ds::SA | ds::ISA | ds::LCP);
+		test_all_ds(str, t);
+		ASSERT_EQ(count_files(), 5U); // SA, PHI, PLCP, LCP and ISA
+	}
+
+	// a cached array needs none of its dependencies
+	{
+		DIR* d = opendir(dir.c_str());
+		while(dirent* e = readdir(d)) {
+			const std::string name = e->d_name;
+			const std::string slot = name.substr(name.rfind('.') + 1);
+			if(slot != "lcp" && slot != "sa" && name[0] != '.') {
+				unlink((dir + "/" + name).c_str());
+			}
+		}
+		closedir(d);
+		ASSERT_EQ(count_files(), 2U);
+
+		auto t = create_algo<TextDS<>>(options, in);
+		t.require(ds::LCP);
+		test_lcp(str, t);
+		ASSERT_EQ(count_files(), 2U); // PHI and PLCP were not constructed
+	}
+
+	// other texts and providers do not use the cached arrays
+	{
+		const std::string other = RandomUniformGenerator::generate(10000, 2, 'a', 'd');
+		test::TestInput other_input = test::compress_input(other);
+		InputView other_in = other_input.as_view();
+		auto t = create_algo<TextDS<>>(options, other_in);
+		test_sa(other, t);
+		ASSERT_EQ(count_files(), 6U);
+	}
+	{
+		auto t = create_algo<TextDS<SAIS>>(options, in);
+		test_sa(str, t);
+		ASSERT_EQ(count_files(), 7U);
+	}
+
+	DIR* d = opendir(dir.c_str());
+	while(dirent* e = readdir(d)) {
+		if(e->d_name[0] != '.') unlink((dir + "/" + e->d_name).c_str());
+	}
+	closedir(d);
+	rmdir(dir.c_str());
+}
@@ -1290,3 +1290,71 @@ TEST(generic_int_vector_application, access_dynamic_autocast) {
     iv_access_autocast_const(iv);
     iv_access_autocast_nonconst(iv);
 }
+
+TEST(generic_int_vector, dynamic_t_bulk_width) {
+    uint64_t x = 1;
+    auto rand = [&]() {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        return x;
+    };
+
+    for (size_t n : { 0, 1, 63, 64, 65, 200 }) {
+        for (uint8_t from = 1; from <= 64; from++) {
+            for (uint8_t to = 1; to <= 64; to++) {
+                IntVector<dynamic_t> iv(n, 0, from);
+                std::vector<uint64_t> expected(n);
+                for (size_t i = 0; i < n; i++) {
+                    const uint64_t v = rand() >> (64 - from);
+                    iv[i] = v;
+                    expected[i] = (to < 64) ? (v & ((1ULL << to) - 1)) : v;
+                }
+
+                iv.width(to);
+                ASSERT_EQ(iv.width(), to);
+                ASSERT_EQ(iv.size(), n);
+                for (size_t i = 0; i < n; i++) {
+                    ASSERT_EQ(uint64_t(iv[i]), expected[i])
+                        << "n = " << n << ", from = " << size_t(from)
+                        << ", to = " << size_t(to) << ", i = " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(generic_int_vector, bulk_unpack) {
+    const size_t n = 300;
+
+    IntVector<dynamic_t> a(n, 0, 11);
+    IntVector<uint_t<7>> b(n, 0);
+    IntVector<uint32_t> c(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        a[i] = (i * 37) % 2048;
+        b[i] = (i * 37) % 128;
+        c[i] = i * 37;
+    }
+
+    std::vector<uint64_t> out(n);
+    for (size_t first : { 0, 1, 64, 70 }) {
+        for (size_t len : { 0, 1, 63, 64, 130 }) {
+            a.unpack(first, len, out.data());
+            for (size_t i = 0; i < len; i++) ASSERT_EQ(out[i], uint64_t(a[first + i]));
+            b.unpack(first, len, out.data());
+            for (size_t i = 0; i < len; i++) ASSERT_EQ(out[i], uint64_t(uint_t<7>(b[first + i])));
+            c.unpack(first, len, out.data());
+            for (size_t i = 0; i < len; i++) ASSERT_EQ(out[i], uint64_t(c[first + i]));
+        }
+    }
+
+    size_t i = 0;
+    a.for_each([&](uint64_t v) {
+        ASSERT_EQ(v, uint64_t(a[i]));
+        i++;
+    });
+    ASSERT_EQ(i, n);
+
+    for (size_t first : { 0, 5, 64, 299 }) {
+        int_vector::ChunkedReader<dynamic_t> r(a, first);
+        for (size_t j = first; j < n; j++) ASSERT_EQ(r.next(), uint64_t(a[j]));
+    }
+}
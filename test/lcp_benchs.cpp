@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <glog/logging.h>
+
+#include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/ds/LCPSuccinct.hpp>
+#include <tudocomp/generators/RandomUniformGenerator.hpp>
+#include <tudocomp/CreateAlgorithm.hpp>
+#include <tudocomp/io.hpp>
+
+// Times the construction, a sequential scan and random accesses of the
+// LCP array built by LCPFromPLCP and by LCPSuccinct.
+//
+// Usage: lcp_benchs_testrunner [text length] [iterations]
+
+using namespace tdc;
+
+using TextDSLCPSuccinct = TextDS<SADivSufSort, PhiFromSA, PLCPFromPhi, LCPSuccinct>;
+
+template<typename F>
+inline double time_ms(size_t iterations, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; ++i) f();
+    std::chrono::duration<double, std::milli> d =
+        std::chrono::steady_clock::now() - start;
+    return d.count() / iterations;
+}
+
+inline void report(const std::string& name, double ms) {
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed
+              << std::setprecision(2) << ms << " ms" << std::endl;
+}
+
+template<class textds_t>
+inline void bench(const std::string& name, io::InputView& in, size_t iterations) {
+    volatile size_t sink = 0;
+
+    report("construct::" + name, time_ms(iterations, [&]{
+        auto t = create_algo<textds_t>("", in);
+        sink = sink + size_t(t.require_lcp()[0]);
+    }));
+
+    auto t = create_algo<textds_t>("", in);
+    auto& lcp = t.require_lcp();
+
+    report("scan::" + name, time_ms(iterations, [&]{
+        size_t sum = 0;
+        for(size_t j = 0; j < lcp.size(); ++j) sum += lcp[j];
+        sink = sink + sum;
+    }));
+
+    report("random::" + name, time_ms(iterations, [&]{
+        size_t sum = 0;
+        uint64_t x = 1;
+        for(size_t j = 0; j < lcp.size(); ++j) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            sum += lcp[(x >> 20) % lcp.size()];
+        }
+        sink = sink + sum;
+    }));
+}
+
+int main(int argc, char** argv) {
+    google::InitGoogleLogging(argv[0]);
+
+    const size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (1ULL << 22);
+    const size_t iterations = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 3;
+
+    const std::string text = RandomUniformGenerator::generate(n, 1, 'a', 'd');
+    Input input(text);
+    input = Input(input, io::InputRestrictions({0}, true));
+    io::InputView in = input.as_view();
+
+    bench<TextDS<>>("from_phi", in, iterations);
+    bench<TextDSLCPSuccinct>("sada", in, iterations);
+    return 0;
+}
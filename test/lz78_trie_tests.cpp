@@ -259,6 +259,22 @@ TEST(Trie, ExtHashTrie) {
     trie_test<ExtHashTrie>();
 }
 
+#include <tudocomp/compressors/lz78/SwissTrie.hpp>
+TEST(TrieStructure, SwissTrie) {
+    trie_test<SwissTrie>(false);
+}
+TEST(Trie, SwissTrie) {
+    trie_test<SwissTrie>();
+}
+
+#include <tudocomp/compressors/lz78/CompactHashTrie.hpp>
+TEST(TrieStructure, CompactHashTrie) {
+    trie_test<CompactHashTrie>(false);
+}
+TEST(Trie, CompactHashTrie) {
+    trie_test<CompactHashTrie>();
+}
+
 // #include <tudocomp/compressors/lz78/MBonsaiTrie.hpp>
 // TEST(TrieStructure, MBonsaiGammaTrie) {
 //     trie_test<MBonsaiGammaTrie>(false);
@@ -4,6 +4,9 @@
 #include <tudocomp/Generator.hpp>
 #include <tudocomp/CreateAlgorithm.hpp>
 
+#include <tudocomp/Statistics.hpp>
+#include <tudocomp/coders/BitCoder.hpp>
+
 #include <tudocomp/compressors/lzss/LZSSCoding.hpp>
 #include <tudocomp/compressors/lzss/LZSSFactors.hpp>
 #include <tudocomp/compressors/lzss/LZSSLiterals.hpp>
@@ -56,6 +59,19 @@ TEST(lzss, factor_buffer_sort) {
     }
 }
 
+TEST(lzss, factor_positions) {
+    // positions are stored in LEN_BITS bits
+    ASSERT_EQ(LEN_BITS / 8, sizeof(len_compact_t));
+    ASSERT_EQ(3 * LEN_BITS / 8, sizeof(lzss::Factor));
+
+    lzss::FactorBuffer buf;
+    buf.emplace_back(LEN_MAX, LEN_MAX - 1, LEN_MAX - 2);
+    ASSERT_EQ(LEN_MAX, len_t(buf[0].pos));
+    ASSERT_EQ(LEN_MAX - 1, len_t(buf[0].src));
+    ASSERT_EQ(LEN_MAX - 2, len_t(buf[0].len));
+    ASSERT_EQ(LEN_MAX - 2, buf.longest_factor());
+}
+
 TEST(lzss, text_literals_empty) {
     lzss::FactorBuffer empty;
     lzss::TextLiterals<std::string> literals("", empty);
@@ -135,6 +151,58 @@ TEST(lzss, text_literals_factors_end) {
     lzss_text_literals_factors(literals, ref_literals, ref_positions);
 }
 
+TEST(lzss, text_literals_statistics) {
+    std::string text = "a__b____cd___e";
+
+    lzss::FactorBuffer factors;
+    factors.emplace_back(1, text.length(), 2);
+    factors.emplace_back(4, text.length(), 4);
+    factors.emplace_back(10, text.length(), 3);
+
+    // counting by iteration
+    lzss::TextLiterals<std::string> literals(text, factors);
+    Statistics counted = literal_statistics(literals);
+    ASSERT_FALSE(literals.has_next());
+    ASSERT_EQ(5, counted.num_literals());
+    for(uliteral_t c : std::string("abcde")) ASSERT_EQ(1, counted.literal_count(c));
+    ASSERT_EQ(0, counted.literal_count('_'));
+
+    // ready-made statistics are used without iterating
+    Statistics stats;
+    stats.add_literal('x');
+    auto with_stats = with_statistics(lzss::TextLiterals<std::string>(text, factors), stats);
+    Statistics given = literal_statistics(with_stats);
+    ASSERT_TRUE(with_stats.has_next());
+    ASSERT_EQ(1, given.num_literals());
+    ASSERT_EQ(1, given.literal_count('x'));
+}
+
+TEST(lzss, encode_text_statistics) {
+    std::string text = "a__b____cd___e";
+
+    lzss::FactorBuffer factors;
+    factors.emplace_back(1, 0, 2);
+    factors.emplace_back(4, 0, 4);
+    factors.emplace_back(10, 0, 3);
+
+    Statistics stats;
+    for(size_t run : {1, 1, 2, 1}) stats.field(lzss::FDIST_FIELD).add(run);
+
+    // encoding with collected statistics must equal encoding without
+    std::stringstream ss_counted, ss_stats;
+    {
+        Output out(ss_counted);
+        BitCoder::Encoder coder(create_env(BitCoder::meta()), out, NoLiterals());
+        lzss::encode_text(coder, text, factors);
+    }
+    {
+        Output out(ss_stats);
+        BitCoder::Encoder coder(create_env(BitCoder::meta()), out, NoLiterals());
+        lzss::encode_text(coder, text, factors, stats);
+    }
+    ASSERT_EQ(ss_counted.str(), ss_stats.str());
+}
+
 TEST(lzss, decode_back_buffer) {
     //lzss::DecodeBackBuffer buffer = create_algo<lzss::DecodeBackBuffer>("", 12);
     lzss::DecodeBackBuffer buffer(12);
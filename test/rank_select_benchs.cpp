@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <sdsl/int_vector.hpp>
+#include <sdsl/rank_support.hpp>
+#include <sdsl/select_support_mcl.hpp>
+
+#include <tudocomp/ds/RankSelectBitVector.hpp>
+
+// Times rank and select queries on RankSelectBitVector against
+// sdsl::rank_support_v and sdsl::select_support_mcl, on random bit vectors
+// with 50% and 1% set bits.
+//
+// Usage: rank_select_benchs_testrunner [bits] [iterations]
+
+using namespace tdc;
+
+template<typename F>
+inline double time_ms(size_t iterations, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; ++i) f();
+    std::chrono::duration<double, std::milli> d =
+        std::chrono::steady_clock::now() - start;
+    return d.count() / iterations;
+}
+
+inline void report(const std::string& name, double ms) {
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(12) << std::fixed
+              << std::setprecision(2) << ms << " ms" << std::endl;
+}
+
+// random bits of the given density in percent
+inline sdsl::bit_vector bits(size_t n, size_t density) {
+    sdsl::bit_vector bv(n, 0);
+    uint64_t x = density;
+    for(size_t i = 0; i < n; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        bv[i] = ((x >> 33) % 100) < density;
+    }
+    return bv;
+}
+
+// the positions of the queries, drawn from [0, n)
+inline std::vector<size_t> queries(size_t n) {
+    std::vector<size_t> q(1ULL << 20);
+    uint64_t x = 1;
+    for(auto& i : q) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        i = (x >> 20) % n;
+    }
+    return q;
+}
+
+inline void bench(size_t n, size_t density, size_t iterations) {
+    const sdsl::bit_vector bv = bits(n, density);
+    const std::string suffix = "::" + std::to_string(density);
+    volatile size_t sink = 0;
+
+    sdsl::rank_support_v<1> sdsl_rank(&bv);
+    sdsl::select_support_mcl<1, 1> sdsl_select(&bv);
+    RankSelectBitVector tdc_bv(bv.data(), bv.size());
+    CHECK_EQ(sdsl_rank.rank(n), tdc_bv.ones());
+
+    const auto rank_q = queries(n);
+    const auto select_q = queries(tdc_bv.ones());
+
+    report("rank::sdsl" + suffix, time_ms(iterations, [&]{
+        size_t sum = 0;
+        for(size_t j : rank_q) sum += sdsl_rank.rank(j);
+        sink = sink + sum;
+    }));
+    report("rank::tdc" + suffix, time_ms(iterations, [&]{
+        size_t sum = 0;
+        for(size_t j : rank_q) sum += tdc_bv.rank1(j);
+        sink = sink + sum;
+    }));
+    report("select::sdsl" + suffix, time_ms(iterations, [&]{
+        size_t sum = 0;
+        for(size_t j : select_q) sum += sdsl_select.select(j + 1);
+        sink = sink + sum;
+    }));
+    report("select::tdc" + suffix, time_ms(iterations, [&]{
+        size_t sum = 0;
+        for(size_t j : select_q) sum += tdc_bv.select1(j + 1);
+        sink = sink + sum;
+    }));
+}
+
+int main(int argc, char** argv) {
+    google::InitGoogleLogging(argv[0]);
+
+    const size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (1ULL << 28);
+    const size_t iterations = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 3;
+
+    bench(n, 50, iterations);
+    bench(n, 1, iterations);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <tudocomp/ds/IntVector.hpp>
+#include <tudocomp/ds/RankSelectBitVector.hpp>
+
+using namespace tdc;
+
+// compares rank and select to a naive computation on random bits
+void test_rank_select(size_t n, double density, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution bit(density);
+
+    std::vector<bool> bits(n);
+    RankSelectBitVector bv(n);
+    for(size_t i = 0; i < n; i++) {
+        bits[i] = bit(rng);
+        bv.set(i, bits[i]);
+    }
+    bv.build();
+
+    size_t ones = 0;
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_EQ(bits[i], bv[i]);
+        ASSERT_EQ(ones, bv.rank1(i));
+        ASSERT_EQ(i - ones, bv.rank0(i));
+        if(bits[i]) {
+            ++ones;
+            ASSERT_EQ(i, bv.select1(ones));
+        }
+    }
+    ASSERT_EQ(ones, bv.rank1(n));
+    ASSERT_EQ(ones, bv.ones());
+}
+
+TEST(RankSelectBitVector, random) {
+    for(size_t n : { 0, 1, 63, 64, 65, 511, 512, 513, 1024, 100000 }) {
+        for(double density : { 0.0, 0.01, 0.5, 0.99, 1.0 }) {
+            test_rank_select(n, density, n);
+        }
+    }
+}
+
+TEST(RankSelectBitVector, sparse) {
+    // set bits far apart, so select has to search many blocks
+    const size_t n = 10000000;
+    RankSelectBitVector bv(n);
+    const std::vector<size_t> pos { 0, 5, 1000, 600000, 600001, 9000000, n - 1 };
+    for(size_t i : pos) bv.set(i);
+    bv.build();
+
+    for(size_t k = 0; k < pos.size(); k++) {
+        ASSERT_EQ(pos[k], bv.select1(k + 1));
+        ASSERT_EQ(k, bv.rank1(pos[k]));
+    }
+    ASSERT_EQ(3U, bv.rank1(600000));
+    ASSERT_EQ(5U, bv.rank1(9000000 - 1));
+}
+
+TEST(RankSelectBitVector, from_words) {
+    BitVector v(1000);
+    for(size_t i = 0; i < v.size(); i += 3) v[i] = 1;
+
+    RankSelectBitVector bv(v.data(), v.size());
+    ASSERT_EQ(334U, bv.ones());
+    for(size_t k = 1; k <= bv.ones(); k++) {
+        ASSERT_EQ(3 * (k - 1), bv.select1(k));
+    }
+
+    // copies keep the support
+    RankSelectBitVector copy = bv;
+    ASSERT_EQ(bv.rank1(500), copy.rank1(500));
+    ASSERT_EQ(bv.select1(100), copy.select1(100));
+}
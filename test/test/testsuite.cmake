@@ -150,3 +150,17 @@ generic_run_test(
     ${ARGN}
 )
 endmacro()
+
+# Plain timing executables with their own main(), run by the bench target
+macro(run_timing test_target)
+generic_run_test(
+    ${test_target}
+    "${test_target}.cpp"
+    ""
+    ""
+    bench
+    build_bench
+    "Bench"
+    ${ARGN}
+)
+endmacro()
@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <regex>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 
 #include <gtest/gtest.h>
@@ -16,6 +18,10 @@
 #include <tudocomp/CreateAlgorithm.hpp>
 #include <tudocomp/io/MMapHandle.hpp>
 #include <tudocomp/ds/TextDS.hpp>
+#include <tudocomp/util/Allocator.hpp>
+#include <tudocomp/ds/IntVectorStorage.hpp>
+#include <tudocomp/util/parallel.hpp>
+#include <tudocomp_stat/StatPhase.hpp>
 
 #include "test/util.hpp"
 
@@ -142,6 +148,123 @@ TEST(Util, pack_integers) {
     }));
 }
 
+template<class alloc_t>
+void allocator_buckets() {
+    // grows many arrays by single values, as the lcpcomp decoders do
+    alloc_t alloc;
+    const size_t n = 1000;
+    std::vector<uint32_t*> buckets(n, nullptr);
+    std::vector<size_t> sizes(n, 0);
+    for(size_t k = 0; k < 50; k++) {
+        for(size_t i = 0; i < n; i++) {
+            buckets[i] = alloc.reallocate(buckets[i], sizes[i], sizes[i] + 1);
+            buckets[i][sizes[i]++] = i * 100 + k;
+        }
+        if(k % 10 == 9) {
+            // free every third array
+            for(size_t i = 0; i < n; i += 3) {
+                alloc.deallocate(buckets[i], sizes[i]);
+                buckets[i] = nullptr;
+                sizes[i] = 0;
+            }
+        }
+    }
+    for(size_t i = 0; i < n; i++) {
+        const size_t first = 50 - sizes[i];
+        for(size_t j = 0; j < sizes[i]; j++) {
+            ASSERT_EQ(i * 100 + first + j, buckets[i][j]);
+        }
+        alloc.deallocate(buckets[i], sizes[i]);
+    }
+    alloc.release();
+}
+
+TEST(Allocator, buckets) {
+    allocator_buckets<alloc::Heap>();
+    allocator_buckets<alloc::Arena>();
+    allocator_buckets<alloc::Pool>();
+}
+
+TEST(Allocator, arena) {
+    alloc::Arena arena;
+    ASSERT_EQ(0, arena.capacity());
+
+    // the most recent allocation is resized in place
+    auto a = arena.allocate<uint64_t>(4);
+    auto b = arena.reallocate(a, 4, 100);
+    ASSERT_EQ(a, b);
+
+    // large allocations get their own chunk
+    auto c = arena.allocate<uint8_t>(alloc::Arena::MIN_CHUNK * 2);
+    c[alloc::Arena::MIN_CHUNK * 2 - 1] = 1;
+    ASSERT_GE(arena.capacity(), 3 * alloc::Arena::MIN_CHUNK);
+
+    arena.release();
+    ASSERT_EQ(0, arena.capacity());
+}
+
+TEST(Allocator, pool) {
+    alloc::Pool pool;
+
+    // resizing within a size class does not move the memory
+    auto a = pool.allocate<uint8_t>(5);
+    ASSERT_EQ(a, pool.reallocate(a, 5, 16));
+    auto b = pool.reallocate(a, 16, 17);
+    ASSERT_NE(a, b);
+
+    // freed memory is reused by its size class
+    auto c = pool.allocate<uint8_t>(12);
+    ASSERT_EQ(a, c);
+    pool.deallocate(b, 17);
+    ASSERT_EQ(b, pool.allocate<uint8_t>(32));
+
+    const size_t capacity = pool.capacity();
+    for(size_t i = 0; i < 100; i++) {
+        pool.deallocate(pool.allocate<uint32_t>(1000), 1000);
+    }
+    ASSERT_LE(pool.capacity(), capacity + 4096);
+}
+
+TEST(IntVector, storage) {
+    using namespace int_vector;
+    const size_t n = Storage::MIN_MAPPED; // 5 MiB in 40 bits
+
+    for(auto kind : { "heap", "hugepages", "file" }) {
+        auto storage = Storage::parse(kind, "/tmp");
+        DynamicIntVector iv;
+        DynamicIntVector small;
+        {
+            StorageScope scope(storage);
+            iv = DynamicIntVector(n, 0, 40);
+            small = DynamicIntVector(100, 0, 40);
+
+            // the scope is local to the thread
+            std::shared_ptr<const Storage> other = storage;
+            std::thread([&]{ other = Storage::current(); }).join();
+            ASSERT_EQ(nullptr, other);
+        }
+        ASSERT_EQ(nullptr, Storage::current());
+        ASSERT_EQ(storage, iv.storage());
+        ASSERT_EQ(storage, small.storage());
+
+        for(size_t i = 0; i < n; i++) iv[i] = i * 1000003;
+
+        // copies and grown vectors keep the storage
+        DynamicIntVector copy = iv;
+        ASSERT_EQ(storage, copy.storage());
+        copy.resize(2 * n);
+        copy.width(48);
+        ASSERT_EQ(storage, copy.storage());
+        for(size_t i = 0; i < n; i++) {
+            ASSERT_EQ(uint64_t(i * 1000003) & ((1ULL << 40) - 1), uint64_t(copy[i]));
+        }
+        ASSERT_EQ(iv.size(), n);
+        ASSERT_EQ(uint64_t(iv[n - 1]), uint64_t((n - 1) * 1000003) & ((1ULL << 40) - 1));
+    }
+
+    ASSERT_THROW(Storage::parse("disk", ""), std::invalid_argument);
+}
+
 TEST(Input, vector) {
     std::vector<uint8_t> v { 97, 98, 99 };
 
@@ -726,6 +849,85 @@ TEST(IO, bits_eof) {
     }
 }
 
+TEST(IO, bits_bulk) {
+    // write byte aligned runs of integers in bulk, so that the block and
+    // SIMD paths are taken, and compare them against single writes
+    std::vector<uint32_t> values;
+    for(uint32_t i = 0; i < 10000; i++) values.push_back(i * 2654435761U);
+    std::vector<uint8_t> bytes;
+    for(size_t i = 0; i < 10007; i++) bytes.push_back(uint8_t(i * 131));
+
+    for(size_t bits : { 8, 13, 16, 32 }) {
+        for(size_t n : { size_t(0), size_t(1), size_t(5), values.size() }) {
+            // a leading bit makes the runs unaligned
+            for(bool aligned : { true, false }) {
+                const uint32_t offset = (bits == 32) ? 0 : 7;
+                std::vector<uint32_t> v(values.begin(), values.begin() + n);
+                for(auto& x : v) x = offset + x % ((1ULL << bits) - offset);
+
+                auto encode = [&](bool bulk) {
+                    std::stringstream ss;
+                    {
+                        Output output(ss);
+                        BitOStream out(output);
+                        if(!aligned) out.write_bit(1);
+                        if(bulk) {
+                            out.write_ints(v.data(), n, bits, offset);
+                            out.write_bytes(bytes.data(), bytes.size());
+                        } else {
+                            for(auto x : v) out.write_int(x - offset, bits);
+                            for(auto b : bytes) out.write_int(b, 8);
+                        }
+                    }
+                    return ss.str();
+                };
+
+                std::string result = encode(true);
+                ASSERT_EQ(encode(false), result) << "bits=" << bits << ", n=" << n;
+
+                Input input(result);
+                BitIStream in(input);
+                if(!aligned) ASSERT_EQ(1, in.read_bit());
+
+                std::vector<uint32_t> v_dec(n);
+                in.read_ints(v_dec.data(), n, bits, offset);
+                ASSERT_EQ(v, v_dec) << "bits=" << bits << ", n=" << n;
+
+                std::vector<uint8_t> bytes_dec(bytes.size());
+                in.read_bytes(bytes_dec.data(), bytes_dec.size());
+                ASSERT_EQ(bytes, bytes_dec);
+                ASSERT_TRUE(in.eof());
+            }
+        }
+    }
+}
+
+#ifndef STATS_DISABLED
+TEST(StatPhase, worker_threads) {
+    // allocations of worker threads count for the phase that started them,
+    // so freeing them in the main thread does not underflow the phase
+    // (the threading runtime may keep a few bytes per thread)
+    const size_t threads = 4;
+    const size_t size = 1ULL << 20;
+
+    StatPhase phase("workers");
+    {
+        std::vector<std::unique_ptr<char[]>> blocks(threads);
+        parallel::for_chunks(threads, threads, 1, [&](size_t, size_t b, size_t e) {
+            for(size_t t = b; t < e; t++) blocks[t].reset(new char[size]);
+        });
+    }
+
+    std::smatch m;
+    const std::string json = phase.to_json().str();
+    ASSERT_TRUE(std::regex_search(json, m, std::regex("\"memPeak\": ?(-?[0-9]+)")));
+    ASSERT_GE(std::stoll(m[1]), ssize_t(threads * size));
+    ASSERT_TRUE(std::regex_search(json, m, std::regex("\"memFinal\": ?(-?[0-9]+)")));
+    ASSERT_GE(std::stoll(m[1]), 0);
+    ASSERT_LT(std::stoll(m[1]), ssize_t(size));
+}
+#endif
+
 TEST(View, construction) {
     static const uint8_t DATA[3] = { 'f', 'o', 'o' };
 